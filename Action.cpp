@@ -0,0 +1,57 @@
+#include "Action.h"
+
+void Action::Execute(model::Move& move) const {
+  switch (kind_) {
+    case Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE: add_to_selection_by_vehicle_type_.Execute(move); break;
+    case Kind::GO_TO: go_to_.Execute(move); break;
+    case Kind::GO_TO_WITH_SPEED_LIMIT: go_to_with_speed_limit_.Execute(move); break;
+    case Kind::NUCLEAR_STRIKE: nuclear_strike_.Execute(move); break;
+    case Kind::ROTATE: rotate_.Execute(move); break;
+    case Kind::SCALE: scale_.Execute(move); break;
+    case Kind::SELECT: select_.Execute(move); break;
+    case Kind::SELECT_BY_VEHICLE_TYPE: select_by_vehicle_type_.Execute(move); break;
+    case Kind::SETUP_VEHICLE_PRODUCTION: setup_vehicle_production_.Execute(move); break;
+  }
+}
+
+const char* Action::Name() const {
+  switch (kind_) {
+    case Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE: return add_to_selection_by_vehicle_type_.Name();
+    case Kind::GO_TO: return go_to_.Name();
+    case Kind::GO_TO_WITH_SPEED_LIMIT: return go_to_with_speed_limit_.Name();
+    case Kind::NUCLEAR_STRIKE: return nuclear_strike_.Name();
+    case Kind::ROTATE: return rotate_.Name();
+    case Kind::SCALE: return scale_.Name();
+    case Kind::SELECT: return select_.Name();
+    case Kind::SELECT_BY_VEHICLE_TYPE: return select_by_vehicle_type_.Name();
+    case Kind::SETUP_VEHICLE_PRODUCTION: return setup_vehicle_production_.Name();
+  }
+  return "";
+}
+
+model::VehicleType Action::SelectedVehicleType() const {
+  switch (kind_) {
+    case Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE: return add_to_selection_by_vehicle_type_.GetVehicleType();
+    case Kind::SELECT_BY_VEHICLE_TYPE: return select_by_vehicle_type_.GetVehicleType();
+    default: return model::VehicleType::_UNKNOWN_;
+  }
+}
+
+bool Action::operator == (const Action& other) const {
+  if (kind_ != other.kind_) {
+    return false;
+  }
+  switch (kind_) {
+    case Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE:
+      return add_to_selection_by_vehicle_type_ == other.add_to_selection_by_vehicle_type_;
+    case Kind::GO_TO: return go_to_ == other.go_to_;
+    case Kind::GO_TO_WITH_SPEED_LIMIT: return go_to_with_speed_limit_ == other.go_to_with_speed_limit_;
+    case Kind::NUCLEAR_STRIKE: return nuclear_strike_ == other.nuclear_strike_;
+    case Kind::ROTATE: return rotate_ == other.rotate_;
+    case Kind::SCALE: return scale_ == other.scale_;
+    case Kind::SELECT: return select_ == other.select_;
+    case Kind::SELECT_BY_VEHICLE_TYPE: return select_by_vehicle_type_ == other.select_by_vehicle_type_;
+    case Kind::SETUP_VEHICLE_PRODUCTION: return setup_vehicle_production_ == other.setup_vehicle_production_;
+  }
+  return false;
+}
@@ -3,16 +3,104 @@
 #define _ACTION_H_
 
 #include "Strategy.h"
-#include <string>
+#include "RingBuffer.h"
+#include "AddToSelectionByVehicleType.h"
+#include "GoTo.h"
+#include "GoToWithSpeedLimit.h"
+#include "NuclearStrike.h"
+#include "Rotate.h"
+#include "Scale.h"
+#include "Select.h"
+#include "SelectByVehicleType.h"
+#include "SetupVehicleProduction.h"
 
 // Implements Command design pattern
 // by turning each of possible sets of settings for a model::Move instance into an object
-// that can be stored in the deque of planned actions
+// that can be stored in the queue of planned actions.
+// Action is a value holding any one of the command classes (a tagged union),
+// so planned actions are stored inline without heap allocations and dispatched without virtual calls.
 class Action {
  public:
-  virtual ~Action() {}
-  virtual void Execute(model::Move& move) const = 0;
-  virtual std::string Name() const = 0;
+  enum class Kind {
+    ADD_TO_SELECTION_BY_VEHICLE_TYPE,
+    GO_TO,
+    GO_TO_WITH_SPEED_LIMIT,
+    NUCLEAR_STRIKE,
+    ROTATE,
+    SCALE,
+    SELECT,
+    SELECT_BY_VEHICLE_TYPE,
+    SETUP_VEHICLE_PRODUCTION
+  };
+
+  // Implicit, so that any command can be added to the queue as is
+  Action(const AddToSelectionByVehicleType& command)
+      : kind_(Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE), add_to_selection_by_vehicle_type_(command) {}
+  Action(const GoTo& command) : kind_(Kind::GO_TO), go_to_(command) {}
+  Action(const GoToWithSpeedLimit& command) : kind_(Kind::GO_TO_WITH_SPEED_LIMIT), go_to_with_speed_limit_(command) {}
+  Action(const NuclearStrike& command) : kind_(Kind::NUCLEAR_STRIKE), nuclear_strike_(command) {}
+  Action(const Rotate& command) : kind_(Kind::ROTATE), rotate_(command) {}
+  Action(const Scale& command) : kind_(Kind::SCALE), scale_(command) {}
+  Action(const Select& command) : kind_(Kind::SELECT), select_(command) {}
+  Action(const SelectByVehicleType& command) : kind_(Kind::SELECT_BY_VEHICLE_TYPE), select_by_vehicle_type_(command) {}
+  Action(const SetupVehicleProduction& command)
+      : kind_(Kind::SETUP_VEHICLE_PRODUCTION), setup_vehicle_production_(command) {}
+
+  // Traits of action kinds, so that the queue can be inspected with integer comparisons
+
+  // Clears the current selection, so the actions planned before it don't rely on what follows
+  static constexpr bool StartsChain(const Kind kind) {
+    return kind == Kind::SELECT || kind == Kind::SELECT_BY_VEHICLE_TYPE;
+  }
+
+  // Changes the current selection
+  static constexpr bool IsSelection(const Kind kind) {
+    return StartsChain(kind) || kind == Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE;
+  }
+
+  // Gives an order to the currently selected vehicles
+  static constexpr bool IsMovement(const Kind kind) {
+    return kind == Kind::GO_TO || kind == Kind::GO_TO_WITH_SPEED_LIMIT || kind == Kind::ROTATE || kind == Kind::SCALE;
+  }
+
+  // Changes the current selection regardless of where the vehicles are,
+  // so repeating it selects the same vehicles even after they have moved
+  static constexpr bool IsSelectionByVehicleType(const Kind kind) {
+    return kind == Kind::SELECT_BY_VEHICLE_TYPE || kind == Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE;
+  }
+
+  // May spend the action points held back for urgent actions (see ActionPointScheduler)
+  static constexpr bool IsUrgent(const Kind kind) {
+    return kind == Kind::NUCLEAR_STRIKE;
+  }
+
+  Kind GetKind() const { return kind_; }
+
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+
+  // The type selected by SELECT_BY_VEHICLE_TYPE or ADD_TO_SELECTION_BY_VEHICLE_TYPE action
+  model::VehicleType SelectedVehicleType() const;
+
+  // Same kind with the same settings
+  bool operator == (const Action& other) const;
+
+ private:
+  Kind kind_;
+  union {
+    AddToSelectionByVehicleType add_to_selection_by_vehicle_type_;
+    GoTo go_to_;
+    GoToWithSpeedLimit go_to_with_speed_limit_;
+    NuclearStrike nuclear_strike_;
+    Rotate rotate_;
+    Scale scale_;
+    Select select_;
+    SelectByVehicleType select_by_vehicle_type_;
+    SetupVehicleProduction setup_vehicle_production_;
+  };
 };
 
+// Planned actions in the order of execution
+using ActionQueue = RingBuffer<Action>;
+
 #endif
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef _ACTION_CHAIN_H_
+#define _ACTION_CHAIN_H_
+
+#include <climits>
+
+// Describes consecutive planned actions that must be made one right after another
+// (e.g. Select -> Scale -> GoTo), so that actions of other chains never get in between.
+// The actions themselves are stored in the queue of the lane the chain belongs to (see ActionScheduler).
+// Every chain giving orders starts with its own selection.
+struct ActionChain {
+  static const int kNoDeadline = INT_MAX;
+
+  const char* name;   // identifies the logic which planned the chain, used for statistics
+  int length;         // number of actions left
+  int enqueue_tick;
+  int deadline_tick;  // the chain is dropped if it hasn't started by then
+  bool is_started;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "ActionPointScheduler.h"
+
+using namespace model;
+
+ActionPointScheduler::ActionPointScheduler(const Game& game)
+    : action_detection_interval_(game.getActionDetectionInterval()),
+      base_action_count_(game.getBaseActionCount()),
+      additional_action_count_per_control_center_(game.getAdditionalActionCountPerControlCenter()) {}
+
+void ActionPointScheduler::StartTick(const Player& me, const World& world, const bool is_strike_pending) {
+  current_tick_ = world.getTickIndex();
+  while (!recent_action_ticks_.empty() &&
+         recent_action_ticks_.front() <= current_tick_ - action_detection_interval_) {
+    recent_action_ticks_.pop_front();
+  }
+
+  int my_control_centers = 0;
+  for (const Facility& facility : world.getFacilities()) {
+    if (facility.getType() == FacilityType::CONTROL_CENTER && facility.getOwnerPlayerId() == me.getId()) {
+      my_control_centers++;
+    }
+  }
+  action_count_limit_ = base_action_count_ + additional_action_count_per_control_center_ * my_control_centers;
+  // The server knows better, e.g. when a control center has just been lost
+  is_on_cooldown_ = me.getRemainingActionCooldownTicks() > 0;
+  // Once the cooldown is over, a strike may never come, so a point is held back only for a strike in sight
+  const int nuclear_strike_cooldown = me.getRemainingNuclearStrikeCooldownTicks();
+  is_urgent_action_expected_ = is_strike_pending ||
+                               (nuclear_strike_cooldown > 0 && nuclear_strike_cooldown < action_detection_interval_);
+}
+
+int ActionPointScheduler::AvailableActionPoints() const {
+  if (is_on_cooldown_) {
+    return 0;
+  }
+  return action_count_limit_ - static_cast<int>(recent_action_ticks_.size());
+}
+
+bool ActionPointScheduler::CanAct(const bool is_urgent) const {
+  const int reserve = !is_urgent && is_urgent_action_expected_ ? kUrgentActionsReserve : 0;
+  return AvailableActionPoints() > reserve;
+}
+
+void ActionPointScheduler::RegisterAction() {
+  recent_action_ticks_.push_back(current_tick_);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef _ACTION_POINT_SCHEDULER_H_
+#define _ACTION_POINT_SCHEDULER_H_
+
+#include "Strategy.h"
+#include "RingBuffer.h"
+
+// Decides on which ticks an action can be made without exceeding the limit set by the rules:
+// at most <base action count> + <additional action count per control center> * <my control centers>
+// actions within any <action detection interval> consecutive ticks.
+// Keeps the ticks of the recent actions, so that the points left unused are spent later,
+// and holds back kUrgentActionsReserve points for urgent actions (Nuclear Strikes)
+// while the nuclear strike cooldown is about to end or a strike is pending.
+class ActionPointScheduler {
+ public:
+  explicit ActionPointScheduler(const model::Game& game);
+
+  // Must be called on each tick before CanAct().
+  // `is_strike_pending` tells if a Nuclear Strike is planned or a launcher for it has been found.
+  void StartTick(const model::Player& me, const model::World& world, const bool is_strike_pending);
+
+  int AvailableActionPoints() const;
+  bool CanAct(const bool is_urgent) const;
+
+  // Must be called when the action is made on the current tick
+  void RegisterAction();
+
+ private:
+  const int kUrgentActionsReserve = 1;
+
+  const int action_detection_interval_;
+  const int base_action_count_;
+  const int additional_action_count_per_control_center_;
+
+  int current_tick_ = 0;
+  int action_count_limit_ = 0;
+  bool is_on_cooldown_ = false;
+  bool is_urgent_action_expected_ = false;
+  RingBuffer<int> recent_action_ticks_;
+};
+
+#endif
@@ -0,0 +1,158 @@
+#include "ActionQueueOptimizer.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+void ActionQueueOptimizer::Optimize(ActionQueue& actions, RingBuffer<ActionChain>& chains) {
+  PROFILE_SCOPE(OPTIMIZE_ACTIONS);
+  is_kept_.assign(actions.size(), true);
+  SplitIntoChains(actions, chains);
+  DropUnusedSelections(actions);
+  DropRepeatedChainsAndSelections(actions);
+
+  kept_actions_.clear();
+  for (size_t i = 0; i < actions.size(); i++) {
+    if (is_kept_[i]) {
+      kept_actions_.push_back(actions[i]);
+    }
+  }
+  if (kept_actions_.size() == actions.size()) {
+    return;
+  }
+  removed_actions_count_ += actions.size() - kept_actions_.size();
+  actions.clear();
+  for (const Action& action : kept_actions_) {
+    actions.push_back(action);
+  }
+
+  // Joined chains become a part of the chain they are joined to
+  kept_chains_.clear();
+  kept_chain_index_.resize(ranges_.size());
+  for (size_t i = 0; i < ranges_.size(); i++) {
+    const ChainRange& range = ranges_[i];
+    const int kept_count = static_cast<int>(std::count(is_kept_.begin() + range.begin, is_kept_.begin() + range.end,
+                                                       true));
+    if (range.joined_to == kNotJoined) {
+      kept_chain_index_[i] = kept_chains_.size();
+      kept_chains_.push_back(chains[i]);
+      kept_chains_.back().length = kept_count;
+    }
+    else {
+      ActionChain& target = kept_chains_[kept_chain_index_[range.joined_to]];
+      target.length += kept_count;
+      target.deadline_tick = std::min(target.deadline_tick, chains[i].deadline_tick);
+    }
+  }
+  chains.clear();
+  for (const ActionChain& chain : kept_chains_) {
+    if (chain.length > 0) {
+      chains.push_back(chain);
+    }
+  }
+}
+
+void ActionQueueOptimizer::SplitIntoChains(const ActionQueue& actions, const RingBuffer<ActionChain>& chains) {
+  ranges_.clear();
+  size_t begin = 0;
+  for (size_t i = 0; i < chains.size(); i++) {
+    ChainRange range = { begin, begin, begin + chains[i].length, 0, false, false, kNotJoined };
+    // The selection of a started chain has been made already
+    if (!chains[i].is_started && Action::StartsChain(actions[begin].GetKind())) {
+      range.selection_end++;
+      while (range.selection_end < range.end && Action::IsSelection(actions[range.selection_end].GetKind())) {
+        range.selection_end++;
+      }
+    }
+    for (size_t j = range.selection_end; j < range.end; j++) {
+      const Action::Kind kind = actions[j].GetKind();
+      if (Action::IsMovement(kind)) {
+        range.movements_count++;
+      }
+      else if (Action::IsSelection(kind)) {
+        range.changes_selection_later = true;
+      }
+    }
+    ranges_.push_back(range);
+    begin = range.end;
+  }
+}
+
+void ActionQueueOptimizer::DropUnusedSelections(const ActionQueue& actions) {
+  for (ChainRange& range : ranges_) {
+    if (range.begin != range.selection_end && range.movements_count == 0) {
+      Drop(actions, range.begin, range.end);
+      range.is_removed = true;
+    }
+  }
+}
+
+void ActionQueueOptimizer::DropRepeatedChainsAndSelections(const ActionQueue& actions) {
+  size_t previous = kNotJoined;
+  // Whether some orders have been joined to the previous chain, so that it isn't what its actions say any more
+  bool is_previous_extended = false;
+  for (size_t i = 0; i < ranges_.size(); i++) {
+    ChainRange& range = ranges_[i];
+    if (range.is_removed) {
+      continue;
+    }
+    if (previous != kNotJoined && range.begin != range.selection_end) {
+      if (!is_previous_extended && AreSame(actions, ranges_[previous], range)) {
+        Drop(actions, range.begin, range.end);
+        range.is_removed = true;
+        continue;
+      }
+      if (!ranges_[previous].changes_selection_later && HaveSameSelection(actions, ranges_[previous], range)) {
+        // The orders of this chain are now given to the selection of the previous one,
+        // as well as the actions left from the removed chains between them
+        Drop(actions, range.begin, range.selection_end);
+        for (size_t j = previous + 1; j <= i; j++) {
+          ranges_[j].joined_to = previous;
+        }
+        is_previous_extended = true;
+        if (range.changes_selection_later) {
+          previous = kNotJoined;
+        }
+        continue;
+      }
+    }
+    previous = i;
+    is_previous_extended = false;
+  }
+}
+
+// Only selections by vehicle type are compared, as the same rectangle
+// may contain other vehicles once the previous orders have been executed
+bool ActionQueueOptimizer::HaveSameSelection(const ActionQueue& actions, const ChainRange& a,
+                                             const ChainRange& b) const {
+  if (a.begin == a.selection_end || a.selection_end - a.begin != b.selection_end - b.begin) {
+    return false;
+  }
+  for (size_t i = 0; i < a.selection_end - a.begin; i++) {
+    const Action& action = actions[a.begin + i];
+    if (!Action::IsSelectionByVehicleType(action.GetKind()) || !(action == actions[b.begin + i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ActionQueueOptimizer::AreSame(const ActionQueue& actions, const ChainRange& a, const ChainRange& b) const {
+  if (a.begin == a.selection_end || a.end - a.begin != b.end - b.begin) {
+    return false;
+  }
+  for (size_t i = 0; i < a.end - a.begin; i++) {
+    if (!(actions[a.begin + i] == actions[b.begin + i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ActionQueueOptimizer::Drop(const ActionQueue& actions, const size_t begin, const size_t end) {
+  for (size_t i = begin; i < end; i++) {
+    const Action::Kind kind = actions[i].GetKind();
+    if (Action::IsSelection(kind) || Action::IsMovement(kind)) {
+      is_kept_[i] = false;
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#ifndef _ACTION_QUEUE_OPTIMIZER_H_
+#define _ACTION_QUEUE_OPTIMIZER_H_
+
+#include "Action.h"
+#include "ActionChain.h"
+#include <vector>
+
+// Peephole pass over a queue of planned actions which removes actions whose effect
+// is overridden before it matters, so that each action point gives an order that changes something.
+// Each chain of the queue consists of its selection (an action starting a chain and the rest of the selection)
+// and orders for the selected vehicles. Actions that don't depend on the selection
+// (Nuclear Strikes, production setups) are never removed. An order followed by another one
+// isn't removed either: it moves the vehicles for the ticks before the next one starts.
+class ActionQueueOptimizer {
+ public:
+  // `chains` describe `actions` and are updated accordingly
+  void Optimize(ActionQueue& actions, RingBuffer<ActionChain>& chains);
+
+  // Total number of actions removed since the start of the game
+  size_t RemovedActionsCount() const { return removed_actions_count_; }
+
+ private:
+  struct ChainRange {
+    size_t begin;
+    size_t selection_end;  // the selection is [begin; selection_end), empty for a chain that has started already
+    size_t end;
+    int movements_count;
+    bool changes_selection_later;  // has selection actions after some of its orders
+    bool is_removed;
+    size_t joined_to;  // index of the chain whose selection the orders of this one are given to
+  };
+
+  static const size_t kNotJoined = static_cast<size_t>(-1);
+
+  void SplitIntoChains(const ActionQueue& actions, const RingBuffer<ActionChain>& chains);
+
+  // A selection which no order is given to
+  void DropUnusedSelections(const ActionQueue& actions);
+
+  // A chain repeating the previous one (e.g. a relocation ordered twice while the queue was busy)
+  // is dropped completely. A chain selecting the same vehicle types as the previous one
+  // loses its selection and is joined to the previous chain, so that its orders go to the vehicles
+  // which are selected already.
+  void DropRepeatedChainsAndSelections(const ActionQueue& actions);
+
+  bool HaveSameSelection(const ActionQueue& actions, const ChainRange& a, const ChainRange& b) const;
+  bool AreSame(const ActionQueue& actions, const ChainRange& a, const ChainRange& b) const;
+
+  // Drops the actions of [begin; end) that depend on the selection
+  void Drop(const ActionQueue& actions, const size_t begin, const size_t end);
+
+  std::vector<ChainRange> ranges_;
+  std::vector<bool> is_kept_;
+  std::vector<Action> kept_actions_;
+  std::vector<ActionChain> kept_chains_;
+  std::vector<size_t> kept_chain_index_;  // index in kept_chains_ by index of the chain
+  size_t removed_actions_count_ = 0;
+};
+
+#endif
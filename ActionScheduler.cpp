@@ -0,0 +1,162 @@
+#include "ActionScheduler.h"
+
+#include <algorithm>
+#include <cstring>
+
+void ActionScheduler::StartTick(const int current_tick) {
+  current_tick_ = current_tick;
+  for (Lane& lane : lanes_) {
+    DropExpiredChains(lane);
+  }
+}
+
+void ActionScheduler::StartChain(const char* name, const ActionPriority& priority, const int max_wait_ticks) {
+  const int deadline_tick = max_wait_ticks == ActionChain::kNoDeadline ? ActionChain::kNoDeadline
+                                                                       : current_tick_ + max_wait_ticks;
+  new_chain_ = { name, 0, current_tick_, deadline_tick, false };
+  new_chain_lane_ = static_cast<size_t>(priority);
+  is_new_chain_added_ = false;
+}
+
+void ActionScheduler::Add(const Action& action) {
+  Lane& lane = lanes_[new_chain_lane_];
+  if (!is_new_chain_added_) {
+    lane.chains.push_back(new_chain_);
+    is_new_chain_added_ = true;
+  }
+  lane.actions.push_back(action);
+  lane.chains.back().length++;
+}
+
+bool ActionScheduler::Empty() const {
+  return FrontLane() == kNoLane;
+}
+
+size_t ActionScheduler::Size() const {
+  size_t size = 0;
+  for (const Lane& lane : lanes_) {
+    size += lane.actions.size();
+  }
+  return size;
+}
+
+size_t ActionScheduler::Size(const ActionPriority& priority) const {
+  return lanes_[static_cast<size_t>(priority)].actions.size();
+}
+
+const Action& ActionScheduler::Front() const {
+  return lanes_[FrontLane()].actions.front();
+}
+
+void ActionScheduler::PopFront() {
+  Lane& lane = lanes_[FrontLane()];
+  ActionChain& chain = lane.chains.front();
+  if (!chain.is_started) {
+    chain.is_started = true;
+    WaitStatistics& statistics = StatisticsFor(chain.name);
+    const int wait_ticks = current_tick_ - chain.enqueue_tick;
+    statistics.started_count++;
+    statistics.total_wait_ticks += wait_ticks;
+    statistics.max_wait_ticks = std::max(statistics.max_wait_ticks, wait_ticks);
+  }
+  lane.actions.pop_front();
+  if (--chain.length == 0) {
+    lane.chains.pop_front();
+  }
+}
+
+bool ActionScheduler::IsFrontChainStarted() const {
+  return lanes_[FrontLane()].chains.front().is_started;
+}
+
+size_t ActionScheduler::FrontChainLength() const {
+  return static_cast<size_t>(lanes_[FrontLane()].chains.front().length);
+}
+
+const Action& ActionScheduler::Peek(const size_t index) const {
+  return lanes_[FrontLane()].actions[index];
+}
+
+void ActionScheduler::Optimize() {
+  for (Lane& lane : lanes_) {
+    optimizer_.Optimize(lane.actions, lane.chains);
+  }
+}
+
+void ActionScheduler::PrintWaitStatistics(std::FILE* output) const {
+  std::fprintf(output, "%-24s %8s %8s %10s %10s\n", "chain", "started", "expired", "mean_wait", "max_wait");
+  for (const WaitStatistics& statistics : wait_statistics_) {
+    const double mean_wait = statistics.started_count > 0
+                             ? static_cast<double>(statistics.total_wait_ticks) / statistics.started_count : 0;
+    std::fprintf(output, "%-24s %8d %8d %10.1f %10d\n", statistics.name, statistics.started_count,
+                 statistics.expired_count, mean_wait, statistics.max_wait_ticks);
+  }
+  std::fprintf(output, "actions removed by the optimizer: %zu\n", optimizer_.RemovedActionsCount());
+}
+
+// At most one chain is started at a time, and it must be finished before any other one starts
+size_t ActionScheduler::FrontLane() const {
+  size_t front_lane = kNoLane;
+  for (size_t i = 0; i < lanes_.size(); i++) {
+    const Lane& lane = lanes_[i];
+    if (lane.chains.empty()) {
+      continue;
+    }
+    if (lane.chains.front().is_started) {
+      return i;
+    }
+    if (front_lane == kNoLane) {
+      front_lane = i;
+    }
+  }
+  return front_lane;
+}
+
+void ActionScheduler::DropExpiredChains(Lane& lane) {
+  bool has_expired_chains = false;
+  for (size_t i = 0; i < lane.chains.size(); i++) {
+    if (!lane.chains[i].is_started && lane.chains[i].deadline_tick < current_tick_) {
+      has_expired_chains = true;
+      break;
+    }
+  }
+  if (!has_expired_chains) {
+    return;
+  }
+
+  kept_actions_.clear();
+  kept_chains_.clear();
+  size_t begin = 0;
+  for (size_t i = 0; i < lane.chains.size(); i++) {
+    const ActionChain& chain = lane.chains[i];
+    const size_t end = begin + chain.length;
+    if (!chain.is_started && chain.deadline_tick < current_tick_) {
+      StatisticsFor(chain.name).expired_count++;
+    }
+    else {
+      kept_chains_.push_back(chain);
+      for (size_t j = begin; j < end; j++) {
+        kept_actions_.push_back(lane.actions[j]);
+      }
+    }
+    begin = end;
+  }
+  lane.actions.clear();
+  for (const Action& action : kept_actions_) {
+    lane.actions.push_back(action);
+  }
+  lane.chains.clear();
+  for (const ActionChain& chain : kept_chains_) {
+    lane.chains.push_back(chain);
+  }
+}
+
+ActionScheduler::WaitStatistics& ActionScheduler::StatisticsFor(const char* name) {
+  for (WaitStatistics& statistics : wait_statistics_) {
+    if (statistics.name == name || std::strcmp(statistics.name, name) == 0) {
+      return statistics;
+    }
+  }
+  wait_statistics_.push_back({ name, 0, 0, 0, 0 });
+  return wait_statistics_.back();
+}
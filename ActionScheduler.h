@@ -0,0 +1,89 @@
+#pragma once
+#ifndef _ACTION_SCHEDULER_H_
+#define _ACTION_SCHEDULER_H_
+
+#include "Action.h"
+#include "ActionChain.h"
+#include "ActionQueueOptimizer.h"
+#include <array>
+#include <cstdio>
+#include <vector>
+
+enum class ActionPriority {
+  URGENT = 0,  // Nuclear Strikes
+  HIGH,        // orders for combat groups and production setups
+  NORMAL,      // regrouping and occupation of facilities
+  LOW,         // relocations and patrols which are ordered again and again
+  _COUNT_
+};
+
+// Holds planned actions as chains (see ActionChain) in a lane per priority.
+// The next action is taken from the chain which has started already, otherwise from the earliest chain
+// of the most important non-empty lane, so that chains are never broken and urgent ones don't wait
+// behind a long backlog of less important ones. Chains that haven't started by their deadline are dropped.
+//
+// A chain is planned with StartChain() followed by Add() for each of its actions.
+class ActionScheduler {
+ public:
+  // Queue-wait time of the chains with the same name
+  struct WaitStatistics {
+    const char* name;
+    int started_count;
+    int expired_count;
+    long long total_wait_ticks;
+    int max_wait_ticks;
+  };
+
+  // Must be called on each tick before anything is planned; drops expired chains
+  void StartTick(const int current_tick);
+
+  void StartChain(const char* name, const ActionPriority& priority,
+                  const int max_wait_ticks = ActionChain::kNoDeadline);
+  void Add(const Action& action);
+
+  bool Empty() const;
+  size_t Size() const;
+  size_t Size(const ActionPriority& priority) const;
+
+  // The action to be made next
+  const Action& Front() const;
+  void PopFront();
+
+  // The chain the next action belongs to: its actions are Peek(0) (i.e. Front()) ... Peek(FrontChainLength() - 1)
+  bool IsFrontChainStarted() const;
+  size_t FrontChainLength() const;
+  const Action& Peek(const size_t index) const;
+
+  // Runs ActionQueueOptimizer over each lane
+  void Optimize();
+
+  const std::vector<WaitStatistics>& ChainWaitStatistics() const { return wait_statistics_; }
+  void PrintWaitStatistics(std::FILE* output) const;
+
+ private:
+  struct Lane {
+    ActionQueue actions;
+    RingBuffer<ActionChain> chains;
+  };
+
+  static const size_t kNoLane = static_cast<size_t>(-1);
+
+  size_t FrontLane() const;
+  void DropExpiredChains(Lane& lane);
+  WaitStatistics& StatisticsFor(const char* name);
+
+  std::array<Lane, static_cast<size_t>(ActionPriority::_COUNT_)> lanes_;
+  int current_tick_ = 0;
+
+  // The chain which is being planned, it is added to its lane with the first action
+  ActionChain new_chain_ = {};
+  size_t new_chain_lane_ = kNoLane;
+  bool is_new_chain_added_ = false;
+
+  ActionQueueOptimizer optimizer_;
+  std::vector<WaitStatistics> wait_statistics_;
+  std::vector<Action> kept_actions_;
+  std::vector<ActionChain> kept_chains_;
+};
+
+#endif
@@ -14,6 +14,10 @@ void AddToSelectionByVehicleType::Execute(model::Move& move) const {
   move.setVehicleType(vehicle_type_);
 }
 
-std::string AddToSelectionByVehicleType::Name() const {
+const char* AddToSelectionByVehicleType::Name() const {
   return "AddToSelectionByVehicleType";
 }
+
+bool AddToSelectionByVehicleType::operator == (const AddToSelectionByVehicleType& other) const {
+  return vehicle_type_ == other.vehicle_type_ && world_side_length_ == other.world_side_length_;
+}
@@ -2,14 +2,16 @@
 #ifndef _ADD_TO_SELECTION_BY_VEHICLE_TYPE_H_
 #define _ADD_TO_SELECTION_BY_VEHICLE_TYPE_H_
 
-#include "Action.h"
+#include "Strategy.h"
 
 // Adds all vehicles of specific type to selection
-class AddToSelectionByVehicleType : public Action {
+class AddToSelectionByVehicleType {
  public:
   AddToSelectionByVehicleType(const model::VehicleType& vehicle_type, const int world_side_length);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  model::VehicleType GetVehicleType() const { return vehicle_type_; }
+  bool operator == (const AddToSelectionByVehicleType& other) const;
 
  private:
   model::VehicleType vehicle_type_;
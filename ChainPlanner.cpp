@@ -0,0 +1,118 @@
+#include "ChainPlanner.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+
+const int ChainPlanner::kStageDepths[] = { 16, 48 };
+const size_t ChainPlanner::kStagesCount = sizeof(kStageDepths) / sizeof(kStageDepths[0]);
+const size_t ChainPlanner::kBeamWidth;
+const int ChainPlanner::kDeadlineCheckTicks;
+constexpr float ChainPlanner::kMinScoreGain;
+
+ChainPlanner::ChainPlanner(const VehicleStore& vehicles,
+                           const std::shared_ptr<const SimulationRules>& rules,
+                           const std::shared_ptr<WorkerPool>& worker_pool,
+                           const std::shared_ptr<const CpuGovernor>& cpu_governor)
+    : vehicles_(vehicles),
+      worker_pool_(worker_pool),
+      cpu_governor_(cpu_governor),
+      loaded_(rules) {}
+
+size_t ChainPlanner::ChooseChain(const long long my_id, const std::vector<CandidateChain>& candidates) {
+  long long vehicle_ticks_left = cpu_governor_->ChainPlanningVehicleTicks();
+  if (candidates.size() < 2 || vehicle_ticks_left <= 0) {
+    return 0;
+  }
+  PROFILE_SCOPE(CHAIN_PLANNING);
+  if (cpu_governor_->CurrentTick() != deadline_tick_) {
+    deadline_tick_ = cpu_governor_->CurrentTick();
+    deadline_ = cpu_governor_->HasChainPlanningDeadline() ?
+      Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                       std::chrono::duration<double>(cpu_governor_->ChainPlanningSeconds())) :
+      Clock::time_point::max();
+  }
+  const Clock::time_point deadline = deadline_;
+
+  loaded_.Load(vehicles_, my_id);
+  rollouts_.resize(candidates.size(), loaded_);
+  scores_.assign(candidates.size(), 0);
+  is_finished_.assign(candidates.size(), 0);
+  beam_.resize(candidates.size());
+  for (size_t candidate = 0; candidate < candidates.size(); candidate++) {
+    beam_[candidate] = candidate;
+  }
+
+  const long long vehicles_count = static_cast<long long>(loaded_.Size());
+  size_t chosen = 0;
+  for (size_t stage = 0; stage < kStagesCount; stage++) {
+    const int previous_depth = stage == 0 ? 0 : kStageDepths[stage - 1];
+    const long long candidate_vehicle_ticks = std::max(1LL, (kStageDepths[stage] - previous_depth) * vehicles_count);
+    const size_t affordable_count = static_cast<size_t>(
+      std::min(static_cast<long long>(beam_.size()), vehicle_ticks_left / candidate_vehicle_ticks));
+    if (affordable_count < 2) {
+      break;
+    }
+    beam_.resize(affordable_count);
+    vehicle_ticks_left -= static_cast<long long>(affordable_count) * candidate_vehicle_ticks;
+
+    const bool is_stage_finished = RunStage(candidates, stage == 0, kStageDepths[stage], deadline);
+    if (is_finished_[0]) {
+      chosen = BestInBeam();
+    }
+    if (!is_stage_finished) {
+      break;
+    }
+
+    // Keeps the first candidate and the best other ones (earlier ones win ties)
+    std::stable_sort(beam_.begin() + 1, beam_.end(), [&](const size_t a, const size_t b) {
+      return scores_[a] > scores_[b];
+    });
+    beam_.resize(std::min(beam_.size(), 1 + kBeamWidth));
+  }
+  return chosen;
+}
+
+bool ChainPlanner::RunStage(const std::vector<CandidateChain>& candidates, const bool is_first_stage, const int depth,
+                           const Clock::time_point& deadline) {
+  worker_pool_->Run(beam_.size(), [&](const size_t chunk, const size_t) {
+    const size_t candidate = beam_[chunk];
+    is_finished_[candidate] = 0;
+    ForwardSimulator& rollout = rollouts_[candidate];
+    if (is_first_stage) {
+      if (Clock::now() >= deadline) {
+        return;
+      }
+      rollout = loaded_;
+      for (const Action& action : candidates[candidate]) {
+        rollout.Apply(action);
+      }
+    }
+    while (rollout.SimulatedTicks() < depth) {
+      if (Clock::now() >= deadline) {
+        return;
+      }
+      rollout.Simulate(std::min(kDeadlineCheckTicks, depth - rollout.SimulatedTicks()));
+    }
+    scores_[candidate] = rollout.DurabilitySum(true) - rollout.DurabilitySum(false);
+    is_finished_[candidate] = 1;
+  });
+  for (const size_t candidate : beam_) {
+    if (!is_finished_[candidate]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t ChainPlanner::BestInBeam() const {
+  size_t best = 0;
+  for (size_t k = 1; k < beam_.size(); k++) {
+    const size_t candidate = beam_[k];
+    if (is_finished_[candidate] && scores_[candidate] >= scores_[0] + kMinScoreGain &&
+        (best == 0 || scores_[candidate] > scores_[best])) {
+      best = candidate;
+    }
+  }
+  return best;
+}
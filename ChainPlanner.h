@@ -0,0 +1,83 @@
+#pragma once
+#ifndef _CHAIN_PLANNER_H_
+#define _CHAIN_PLANNER_H_
+
+#include "Action.h"
+#include "CpuGovernor.h"
+#include "ForwardSimulator.h"
+#include "SimulationRules.h"
+#include "VehicleStore.h"
+#include "WorkerPool.h"
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Actions of a chain which may be planned instead of other ones
+using CandidateChain = std::vector<Action>;
+
+// Chooses one of several candidate chains for the same decision by rolling the world forward with each of them
+// (see ForwardSimulator) and comparing durability of my vehicles and enemy ones afterwards.
+// The search is a beam over rollout depths: all candidates are rolled forward for a few ticks, the best of them
+// are rolled further, and so on. Candidates of a stage are rolled in parallel, one per chunk of WorkerPool.
+//
+// The first candidate is the chain the strategy would plan on its own: another one is chosen only if its rollout
+// ends noticeably better. Planning is bounded by a number of simulated vehicle-ticks
+// (see CpuGovernor::ChainPlanningVehicleTicks()), so the choice doesn't depend on timing: a stage rolls only
+// the candidates of the beam (in their order) which the rest of the budget covers, and the search stops
+// when it covers less than two of them.
+// A wall-clock deadline, shared by all decisions of a tick (see CpuGovernor::ChainPlanningSeconds()), is a safety cap,
+// which may be disabled: when it comes, the choice is made among the candidates which have been rolled
+// to the deepest stage the first one has reached.
+class ChainPlanner {
+ public:
+  ChainPlanner(const VehicleStore& vehicles,
+               const std::shared_ptr<const SimulationRules>& rules,
+               const std::shared_ptr<WorkerPool>& worker_pool,
+               const std::shared_ptr<const CpuGovernor>& cpu_governor);
+
+  // Returns index of the chosen candidate (0 if there is a single one or no budget to compare them)
+  size_t ChooseChain(const long long my_id, const std::vector<CandidateChain>& candidates);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  // Number of ticks every candidate of a stage is rolled forward to
+  static const int kStageDepths[];
+  static const size_t kStagesCount;
+  // Number of candidates (besides the first one) which are rolled further after each stage
+  static const size_t kBeamWidth = 2;
+  // The deadline is checked between slices of a rollout
+  static const int kDeadlineCheckTicks = 10;
+  // Advantage (in durability) another candidate must have over the first one
+  static constexpr float kMinScoreGain = 10.0f;
+
+  // Rolls candidates of the beam forward to `depth` ticks (the first stage starts them from the loaded state);
+  // returns false if some of them missed the deadline
+  bool RunStage(const std::vector<CandidateChain>& candidates, const bool is_first_stage, const int depth,
+                const Clock::time_point& deadline);
+
+  // The best of the candidates of the beam which finished the last stage
+  size_t BestInBeam() const;
+
+  const VehicleStore& vehicles_;
+  const std::shared_ptr<WorkerPool> worker_pool_;
+  const std::shared_ptr<const CpuGovernor> cpu_governor_;
+
+  // State of the world on the current tick
+  ForwardSimulator loaded_;
+
+  // Per-candidate rollouts and their state; kept between calls, so that their buffers are reused
+  std::vector<ForwardSimulator> rollouts_;
+  std::vector<float> scores_;
+  std::vector<std::uint8_t> is_finished_;
+
+  // Indices of the candidates rolled forward on the current stage, the first one is always 0
+  std::vector<size_t> beam_;
+
+  // Deadline of the decisions of the tick
+  int deadline_tick_ = -1;
+  Clock::time_point deadline_;
+};
+
+#endif
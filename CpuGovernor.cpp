@@ -0,0 +1,94 @@
+#include "CpuGovernor.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+constexpr double CpuGovernor::kDefaultSecondsPerTick;
+constexpr long long CpuGovernor::kChainPlanningVehicleTicksByLevel[];
+constexpr double CpuGovernor::kChainPlanningBudgetShare;
+
+double CpuGovernor::BudgetFromEnvironment(const int tick_count) {
+  const char* budget = std::getenv("MY_STRATEGY_CPU_BUDGET_SECONDS");
+  if (budget != nullptr) {
+    const double budget_seconds = std::strtod(budget, nullptr);
+    if (budget_seconds > 0) {
+      return budget_seconds;
+    }
+  }
+  return kDefaultSecondsPerTick * tick_count;
+}
+
+bool CpuGovernor::IsChainPlanningDeadlineDisabledInEnvironment() {
+  return std::getenv("MY_STRATEGY_NO_PLANNING_DEADLINE") != nullptr;
+}
+
+bool CpuGovernor::PinnedLevelFromEnvironment(QualityLevel& level) {
+  const char* level_name = std::getenv("MY_STRATEGY_QUALITY_LEVEL");
+  if (level_name == nullptr) {
+    return false;
+  }
+  for (int i = 0; i < static_cast<int>(QualityLevel::_COUNT_); i++) {
+    if (std::strcmp(level_name, LevelName(static_cast<QualityLevel>(i))) == 0) {
+      level = static_cast<QualityLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+CpuGovernor::CpuGovernor(const double budget_seconds, const int tick_count, const int planning_interval,
+                         std::FILE* log)
+    : budget_seconds_(budget_seconds),
+      tick_count_(tick_count),
+      planning_interval_(std::max(1, planning_interval)),
+      log_(log) {}
+
+void CpuGovernor::RegisterMove(const int current_tick, const double cpu_seconds) {
+  used_seconds_ += cpu_seconds;
+  last_registered_tick_ = current_tick;
+  if (is_level_pinned_ || current_tick < kWarmupTicks || current_tick % kCheckInterval != 0 ||
+      current_tick - last_step_tick_ < kMinTicksBetweenSteps) {
+    return;
+  }
+  const QualityLevel lowest_level = static_cast<QualityLevel>(static_cast<int>(QualityLevel::_COUNT_) - 1);
+  if (level_ == lowest_level) {
+    return;
+  }
+
+  // Assumes that the rest of the game costs as much per tick as the game so far
+  const double projected_seconds = used_seconds_ / (current_tick + 1) * tick_count_;
+  if (projected_seconds > budget_seconds_) {
+    const QualityLevel previous_level = level_;
+    level_ = static_cast<QualityLevel>(static_cast<int>(level_) + 1);
+    last_step_tick_ = current_tick;
+    if (log_ != nullptr) {
+      std::fprintf(log_, "CpuGovernor: tick %d, %.2f s used, %.2f s projected for %d ticks (budget %.2f s): "
+                   "quality %s -> %s\n", current_tick, used_seconds_, projected_seconds, tick_count_,
+                   budget_seconds_, LevelName(previous_level), LevelName(level_));
+    }
+  }
+}
+
+double CpuGovernor::ChainPlanningSeconds() const {
+  const int ticks_left = std::max(1, tick_count_ - CurrentTick());
+  const int planning_ticks_left = (ticks_left + planning_interval_ - 1) / planning_interval_;
+  return std::max(0.0, budget_seconds_ - used_seconds_) * kChainPlanningBudgetShare / planning_ticks_left;
+}
+
+void CpuGovernor::PinLevel(const QualityLevel& level) {
+  level_ = level;
+  is_level_pinned_ = true;
+  if (log_ != nullptr) {
+    std::fprintf(log_, "CpuGovernor: quality pinned to %s\n", LevelName(level_));
+  }
+}
+
+const char* CpuGovernor::LevelName(const QualityLevel& level) {
+  switch (level) {
+    case QualityLevel::FULL: return "FULL";
+    case QualityLevel::REDUCED: return "REDUCED";
+    case QualityLevel::MINIMAL: return "MINIMAL";
+    default: return "UNKNOWN";
+  }
+}
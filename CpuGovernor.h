@@ -0,0 +1,105 @@
+#pragma once
+#ifndef _CPU_GOVERNOR_H_
+#define _CPU_GOVERNOR_H_
+
+#include <cstddef>
+#include <cstdio>
+
+// Keeps track of CPU time spent in MyStrategy::move() against the budget for the whole game.
+// If the usage projected onto the remaining ticks exceeds the budget,
+// the expensive parts of the strategy are switched to cheaper (and less precise) modes step by step.
+// Every step is logged, so that it's visible when and why the quality dropped.
+class CpuGovernor {
+ public:
+  enum class QualityLevel {
+    FULL = 0,
+    REDUCED,   // the closest enemy to my air vehicles is looked for from a single fragment,
+               // nuclear launcher candidates are taken from twice as large fragments,
+               // candidate action chains are rolled forward for fewer ticks
+    MINIMAL,   // nuclear launcher candidates are taken from four times as large fragments,
+               // candidate action chains aren't compared (the strategy's own choice is taken)
+    _COUNT_
+  };
+
+  static constexpr double kDefaultSecondsPerTick = 0.01;
+
+  // The budget is read from MY_STRATEGY_CPU_BUDGET_SECONDS environment variable if it's set,
+  // otherwise it's kDefaultSecondsPerTick for each tick of the game
+  static double BudgetFromEnvironment(const int tick_count);
+
+  // Whether MY_STRATEGY_NO_PLANNING_DEADLINE environment variable is set
+  static bool IsChainPlanningDeadlineDisabledInEnvironment();
+
+  // The level is pinned if MY_STRATEGY_QUALITY_LEVEL environment variable is set to FULL, REDUCED or MINIMAL;
+  // returns false if it isn't set (or set to something else)
+  static bool PinnedLevelFromEnvironment(QualityLevel& level);
+
+  // Candidate action chains are compared only on planning ticks, every `planning_interval` ticks
+  CpuGovernor(const double budget_seconds, const int tick_count, const int planning_interval,
+              std::FILE* log = stderr);
+
+  // Must be called after each move with CPU time it took
+  void RegisterMove(const int current_tick, const double cpu_seconds);
+
+  // Fixes the level for the rest of the game, so that it doesn't depend on the time moves take
+  void PinLevel(const QualityLevel& level);
+
+  // Comparison of candidate action chains is then bounded only by ChainPlanningVehicleTicks()
+  void DisableChainPlanningDeadline() { is_chain_planning_deadline_enabled_ = false; }
+
+  QualityLevel Level() const { return level_; }
+
+  // Side of fragments which nuclear launcher candidates represent, in doubled fragments
+  unsigned int LauncherFragmentScale() const { return 1u << static_cast<unsigned int>(level_); }
+
+  // Whether the distance between my air vehicles and the enemy is measured from every dense fragment
+  bool IsAirDistanceRefined() const { return level_ == QualityLevel::FULL; }
+
+  // Number of vehicle-ticks (vehicles multiplied by ticks) which may be simulated for comparing
+  // candidate action chains on a single decision (0 if they aren't compared)
+  long long ChainPlanningVehicleTicks() const {
+    return kChainPlanningVehicleTicksByLevel[static_cast<size_t>(level_)];
+  }
+
+  bool HasChainPlanningDeadline() const { return is_chain_planning_deadline_enabled_; }
+
+  // Wall-clock limit of the comparisons on the current tick (shared by all its decisions), in case
+  // the vehicle-ticks take longer than expected: a part of the budget left, spread over the planning ticks left,
+  // so that planning alone doesn't make the level step down
+  double ChainPlanningSeconds() const;
+
+  // The tick of the move which is being made (the one after the last registered move)
+  int CurrentTick() const { return last_registered_tick_ + 1; }
+
+  double UsedSeconds() const { return used_seconds_; }
+
+ private:
+  static const char* LevelName(const QualityLevel& level);
+
+  // Enough for all stages of ChainPlanner with a few candidates and a thousand vehicles
+  static constexpr long long kChainPlanningVehicleTicksByLevel[static_cast<size_t>(QualityLevel::_COUNT_)] = {
+    200000, 80000, 0
+  };
+  // Part of the budget left which may be spent on comparing candidate action chains
+  static constexpr double kChainPlanningBudgetShare = 0.5;
+
+  // Time of the first ticks (with initialization) says little about the rest of the game
+  const int kWarmupTicks = 100;
+  const int kCheckInterval = 50;
+  // A lower level must have a chance to show its effect before the next step
+  const int kMinTicksBetweenSteps = 500;
+
+  const double budget_seconds_;
+  const int tick_count_;
+  const int planning_interval_;
+  std::FILE* const log_;
+
+  double used_seconds_ = 0;
+  int last_registered_tick_ = -1;
+  QualityLevel level_ = QualityLevel::FULL;
+  bool is_level_pinned_ = false;
+  bool is_chain_planning_deadline_enabled_ = true;
+  int last_step_tick_ = -kMinTicksBetweenSteps;
+};
+
+#endif
@@ -2,68 +2,94 @@
 
 #include "Action.h"
 #include "GoTo.h"
+#include "Profiler.h"
 
 #include <algorithm>
 
 using std::vector;
 using std::pair;
 using std::make_pair;
-using std::deque;
 
 void DecisionMaker::InitializeHelperClasses(const World& world, const Game& game) {
   vehicle_value_estimator_ = std::make_shared<VehicleValueEstimator>();
   runtime_constants_ = std::make_shared<RuntimeConstants>(world, game);
-  motionlesness_checker_ = std::make_shared<MotionlessnessChecker>(vehicle_by_id_, vehicle_coordinates_update_tick_by_id_,
+  spatial_grid_ = std::make_shared<SpatialGrid>(vehicles_, runtime_constants_->kWorldSideLength,
+                                                runtime_constants_->kFragmentSideLength);
+  motionlesness_checker_ = std::make_shared<MotionlessnessChecker>(vehicles_, world.getMyPlayer().getId(),
                                                                    kAllVehicles.size());
-  nuclear_attack_handler_ = std::make_shared<NuclearAttackHandler>(vehicle_by_id_, vehicle_value_estimator_,
-                                                                   runtime_constants_, motionlesness_checker_);
+  facility_map_ = std::make_shared<FacilityMap>(world.getFacilities(), game, runtime_constants_->kWorldSideLength,
+                                                runtime_constants_->kFragmentSideLength);
+  facility_occupancy_ = std::make_shared<FacilityOccupancy>(vehicles_, facility_map_, world.getMyPlayer().getId());
+  worker_pool_ = std::make_shared<WorkerPool>();
+  cpu_governor_ = std::make_shared<CpuGovernor>(CpuGovernor::BudgetFromEnvironment(world.getTickCount()),
+                                                world.getTickCount(), BaseUniformActionInterval());
+  CpuGovernor::QualityLevel pinned_level;
+  if (CpuGovernor::PinnedLevelFromEnvironment(pinned_level)) {
+    cpu_governor_->PinLevel(pinned_level);
+  }
+  if (CpuGovernor::IsChainPlanningDeadlineDisabledInEnvironment()) {
+    cpu_governor_->DisableChainPlanningDeadline();
+  }
+  nuclear_attack_handler_ = std::make_shared<NuclearAttackHandler>(vehicles_, spatial_grid_, vehicle_value_estimator_,
+                                                                   runtime_constants_, motionlesness_checker_,
+                                                                   worker_pool_, cpu_governor_);
+  simulation_rules_ = std::make_shared<SimulationRules>(world, game);
+  chain_planner_ = std::make_shared<ChainPlanner>(vehicles_, simulation_rules_, worker_pool_, cpu_governor_);
 }
 
-void DecisionMaker::CheckMyVehiclesMotionlessness(const Player& me, const int current_tick) const {
-  motionlesness_checker_->CheckMyVehiclesMotionlessness(me, current_tick);
+void DecisionMaker::CheckMyVehiclesMotionlessness(const int current_tick) const {
+  PROFILE_SCOPE(CHECK_MOTIONLESSNESS);
+  motionlesness_checker_->CheckMyVehiclesMotionlessness(current_tick);
 }
 
 void DecisionMaker::NuclearOperations(const Player& me, const int current_tick,
-                                      deque<std::unique_ptr<Action>>& actions) const {
+                                      ActionScheduler& actions) const {
+  PROFILE_SCOPE(NUCLEAR_OPERATIONS);
   const Vect bottom_right_figher = BottomRightVehiclePositionByType(me, VehicleType::FIGHTER);
   nuclear_attack_handler_->TrySendingNuclearCrew(me, current_tick, bottom_right_figher, actions);
-  nuclear_attack_handler_->TryNuclearStrike(me, actions);
+  nuclear_attack_handler_->TryNuclearStrike(me, current_tick, actions);
+}
+
+void DecisionMaker::PlanIdleWork(const Player& me, IdleWorkScheduler& idle_work) const {
+  nuclear_attack_handler_->PlanLauncherScoring(me, BaseUniformActionInterval(), idle_work);
+}
+
+bool DecisionMaker::IsNuclearStrikePending() const {
+  return nuclear_attack_handler_->HasPreparedLauncher();
 }
 
 // Save the information about vehicles visible from the current tick
 void DecisionMaker::AddNewVehicleInfo(const Vehicle& vehicle, const int current_tick) {
-  const long long vehicle_id = vehicle.getId();
-  vehicle_by_id_[vehicle_id] = vehicle;
-  vehicle_coordinates_by_id_[vehicle_id] = Vect(vehicle);
-  vehicle_coordinates_update_tick_by_id_[vehicle_id] = current_tick;
-  update_tick_by_vehicle_id_[vehicle_id] = current_tick;
+  vehicles_.Add(vehicle, current_tick);
+  spatial_grid_->Insert(vehicle.getId());
+  facility_occupancy_->Insert(vehicle.getId());
+  motionlesness_checker_->RegisterMove(vehicle.getId(), current_tick);
 }
 
 // Update the information about vehicles that we saw on previous tick as well
 void DecisionMaker::UpdateVehicleInfo(const VehicleUpdate& vehicle_update, const int current_tick) {
-  const long long vehicle_id = vehicle_update.getId();
-  
   if (vehicle_update.getDurability() == 0) {
     // If the update tells that the vehicle was destroyed
-    vehicle_by_id_.erase(vehicle_id);
-    update_tick_by_vehicle_id_.erase(vehicle_id);
-    vehicle_coordinates_by_id_.erase(vehicle_id);
-    vehicle_coordinates_update_tick_by_id_.erase(vehicle_id);
+    spatial_grid_->Remove(vehicle_update.getId());
+    facility_occupancy_->Remove(vehicle_update.getId());
+    motionlesness_checker_->Forget(vehicle_update.getId());
+    vehicles_.Remove(vehicle_update.getId());
   }
   else {
     // If the update tells that the vehicle's health and/or position changed
-    vehicle_by_id_[vehicle_id] = Vehicle(vehicle_by_id_[vehicle_id], vehicle_update);
-    update_tick_by_vehicle_id_[vehicle_id] = current_tick;
-    const Vect& target = vehicle_coordinates_by_id_[vehicle_id];
-
-    // Checks that the vehicle indeed moved after previous tick
-    if (vehicle_by_id_[vehicle_id].getDistanceTo(target.x, target.y) > kSmallEps) {
-      vehicle_coordinates_by_id_[vehicle_id] = Vect(vehicle_by_id_[vehicle_id]);
-      vehicle_coordinates_update_tick_by_id_[vehicle_id] = current_tick;
+    // (position is saved only if the vehicle indeed moved after previous tick)
+    if (vehicles_.Update(vehicle_update, current_tick, kSmallEps)) {
+      spatial_grid_->Move(vehicle_update.getId());
+      facility_occupancy_->Move(vehicle_update.getId());
+      motionlesness_checker_->RegisterMove(vehicle_update.getId(), current_tick);
     }
   }
 }
 
+void DecisionMaker::RegisterMoveCpuTime(const int current_tick, const double cpu_seconds) {
+  cpu_governor_->RegisterMove(current_tick, cpu_seconds);
+}
+
 int DecisionMaker::BaseUniformActionInterval() const {
   return runtime_constants_->kBaseUniformActionInterval;
 }
@@ -73,20 +99,21 @@ Vect DecisionMaker::BottomRightVehiclePositionByType(const Player& me, const Veh
   bool at_least_one_found = false;
 
   // Considering all my vehicles of desired type
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    if (vehicle.getPlayerId() == me.getId() && vehicle.getType() == vehicle_type) {
+  const long long my_id = me.getId();
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+    if (vehicles_.PlayerId(slot) == my_id && vehicles_.Type(slot) == vehicle_type) {
+      const Vect vehicle_position = vehicles_.Position(slot);
       if (!at_least_one_found) {
         // the first vehicle under consideration (it's indeed the rightmost one - for the moment)
-        current_best = Vect(vehicle);
+        current_best = vehicle_position;
         at_least_one_found = true;
       }
       else {
         // if currently considered vehicle is far enough to the right from the temporary rightmost one
-        if (current_best.x + kLargeEps < vehicle.getX() ||
+        if (current_best.x + kLargeEps < vehicle_position.x ||
             // or if it is not far enough to the left AND far enough downwards
-            current_best.x < vehicle.getX() + kLargeEps && current_best.y + kLargeEps < vehicle.getY()) {
-          current_best = Vect(vehicle);
+            current_best.x < vehicle_position.x + kLargeEps && current_best.y + kLargeEps < vehicle_position.y) {
+          current_best = vehicle_position;
         }
       }
     }
@@ -99,40 +126,23 @@ Vect DecisionMaker::BottomRightVehiclePositionByType(const Player& me, const Veh
 }
 
 Vect DecisionMaker::ClosestEnemyPosition(const Player& me, const Vect& anchor_point) const {
-  double shortest_distance = kInfiniteDistance;
-  Vect best_target_position;
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    if (vehicle.getPlayerId() != me.getId()) {
-      const Vect vehicle_position = Vect(vehicle);
-      const double distance_to_vehicle = (vehicle_position - anchor_point).Length();
-      if (distance_to_vehicle < shortest_distance) {
-        best_target_position = vehicle_position;
-        shortest_distance = distance_to_vehicle;
-      }
-    }
+  const long long my_id = me.getId();
+  const size_t closest_enemy = spatial_grid_->Nearest(anchor_point, [&](const size_t slot) {
+    return vehicles_.PlayerId(slot) != my_id;
+  });
+  if (closest_enemy == VehicleStore::kNoSlot) {
+    return Vect();
   }
-  return best_target_position;
+  return vehicles_.Position(closest_enemy);
 }
 
 Vect DecisionMaker::MassCenterForVehiclesByTypes(const Player& player, const std::vector<VehicleType>& types) const {
+  // running totals are maintained by the vehicle store, so the cost depends only on the number of types
   Vect sum_position;
   int cnt = 0;
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    if (vehicle.getPlayerId() == player.getId()) {
-      bool matches_type = false;
-      for (const VehicleType& desired_type : types) {
-        if (vehicle.getType() == desired_type) {
-          matches_type = true;
-          break;
-        }
-      }
-      if (matches_type) {
-        sum_position += Vect(vehicle);
-        cnt++;
-      }
-    }
+  for (const VehicleType& desired_type : types) {
+    sum_position += vehicles_.PositionSumByType(player.getId(), desired_type);
+    cnt += vehicles_.CountByType(player.getId(), desired_type);
   }
   if (cnt > 0) {
     return sum_position / cnt;
@@ -149,3 +159,13 @@ Vect DecisionMaker::MassCenterForVehiclesByType(const Player& player, const Vehi
 Vect DecisionMaker::MassCenterForGroundVehicles(const Player& player) const {
   return MassCenterForVehiclesByTypes(player, kGroundVehicles);
 }
+
+void DecisionMaker::PlanChosenChain(const Player& me, const char* name, const ActionPriority& priority,
+                                    const int max_wait_ticks, const std::vector<CandidateChain>& candidates,
+                                    ActionScheduler& actions) const {
+  const size_t chosen = chain_planner_->ChooseChain(me.getId(), candidates);
+  actions.StartChain(name, priority, max_wait_ticks);
+  for (const Action& action : candidates[chosen]) {
+    actions.Add(action);
+  }
+}
@@ -4,14 +4,20 @@
 
 #include "Strategy.h"
 #include "Vect.h"
-#include "Action.h"
+#include "ActionScheduler.h"
 #include "NuclearAttackHandler.h"
 #include "VehicleValueEstimator.h"
 #include "RuntimeConstants.h"
 #include "MotionlessnessChecker.h"
+#include "VehicleStore.h"
+#include "SpatialGrid.h"
+#include "FacilityMap.h"
+#include "FacilityOccupancy.h"
+#include "WorkerPool.h"
+#include "CpuGovernor.h"
+#include "SimulationRules.h"
+#include "ChainPlanner.h"
 
-#include <map>
-#include <deque>
 #include <vector>
 #include <memory>
 
@@ -19,7 +25,8 @@ using namespace model;
 
 // Core class for the entire strategy:
 // - Interacts with helper classes
-// (RuntimeConstants, MotionlessnessChecker, NuclearAttackHandler, and VehicleValueEstimator).
+// (RuntimeConstants, MotionlessnessChecker, NuclearAttackHandler, VehicleValueEstimator, SpatialGrid,
+// FacilityMap, FacilityOccupancy, WorkerPool, CpuGovernor, and ChainPlanner).
 // - Connects MyStrategy (i.e. the entry point) and
 // two classes (derived from this one) that define rules-specific strategies (with/without buildings).
 // - Methods and fields defined here are used by both above-mentioned classes.
@@ -29,27 +36,39 @@ class DecisionMaker {
 
   // Derived classes define rules-specific strategies here
   virtual void MakeDecisions(const Player& me, const World& world, const Game& game,
-                             Move& move, std::deque<std::unique_ptr<Action>>& actions) = 0;
+                             Move& move, ActionScheduler& actions) = 0;
 
   // Initializes classes
   void InitializeHelperClasses(const World& world, const Game& game);
 
   // Updates indicators of motionlessness for each type of vehicles
-  void CheckMyVehiclesMotionlessness(const Player& me, const int current_tick) const;
+  void CheckMyVehiclesMotionlessness(const int current_tick) const;
 
   // Sends vehicles to launch nuclear strike and strikes when possible
   void NuclearOperations(const Player& me, const int current_tick,
-                         std::deque<std::unique_ptr<Action>>& actions) const;
+                         ActionScheduler& actions) const;
+
+  // Schedules analysis that can be done on the ticks before the next planning tick
+  void PlanIdleWork(const Player& me, IdleWorkScheduler& idle_work) const;
+
+  // Whether a launcher for a Nuclear Strike has been found on idle ticks
+  bool IsNuclearStrikePending() const;
 
   // Processes all the information updates on all visible vehicles every tick
   // (these functions exist only because of the way that the game uses to inform players about updates)
   void AddNewVehicleInfo(const Vehicle& vehicle, const int current_tick);
   void UpdateVehicleInfo(const VehicleUpdate& vehicle_update, const int current_tick);
 
+  // Reports CPU time of a move to CpuGovernor, which may switch expensive analysis to cheaper modes
+  void RegisterMoveCpuTime(const int current_tick, const double cpu_seconds);
+
   // Returns required pause between two consecutive actions
   // (assuming that the player distributes action points evenly throughout the entire game duration)
   int BaseUniformActionInterval() const;
 
+  // States of all vehicles known so far
+  const VehicleStore& Vehicles() const { return vehicles_; }
+
  protected:
   // Finds a position of the rightmost vehicle of specific type.
   // If there are several vehicles with X-coordinate close to the maximum,
@@ -64,6 +83,11 @@ class DecisionMaker {
   Vect MassCenterForVehiclesByType(const Player& player, const VehicleType& vehicle_type) const;
   Vect MassCenterForGroundVehicles(const Player& player) const;
 
+  // Plans the chain chosen by ChainPlanner among the candidates
+  // (the first candidate is the one the strategy would plan without comparing them)
+  void PlanChosenChain(const Player& me, const char* name, const ActionPriority& priority, const int max_wait_ticks,
+                       const std::vector<CandidateChain>& candidates, ActionScheduler& actions) const;
+
   const std::vector<VehicleType> kGroundVehicles = { VehicleType::ARRV, VehicleType::IFV, VehicleType::TANK };
   const std::vector<VehicleType> kAirVehicles = { VehicleType::FIGHTER, VehicleType::HELICOPTER };
   const std::vector<VehicleType> kAllVehicles = { VehicleType::ARRV, VehicleType::IFV, VehicleType::TANK, VehicleType::FIGHTER, VehicleType::HELICOPTER };
@@ -77,12 +101,16 @@ class DecisionMaker {
   std::shared_ptr<VehicleValueEstimator> vehicle_value_estimator_;
   std::shared_ptr<RuntimeConstants> runtime_constants_;
   std::shared_ptr<MotionlessnessChecker> motionlesness_checker_;
+  std::shared_ptr<SpatialGrid> spatial_grid_;
+  std::shared_ptr<FacilityMap> facility_map_;
+  std::shared_ptr<FacilityOccupancy> facility_occupancy_;
+  std::shared_ptr<WorkerPool> worker_pool_;
+  std::shared_ptr<CpuGovernor> cpu_governor_;
+  std::shared_ptr<SimulationRules> simulation_rules_;
+  std::shared_ptr<ChainPlanner> chain_planner_;
 
   // states of all visible vehicles in the world
-  std::map<long long, Vehicle> vehicle_by_id_;
-  std::map<long long, int> update_tick_by_vehicle_id_; // anything (health/position) updated
-  std::map<long long, Vect> vehicle_coordinates_by_id_;
-  std::map<long long, int> vehicle_coordinates_update_tick_by_id_;
+  VehicleStore vehicles_;
 };
 
 #endif
@@ -5,19 +5,22 @@
 #include "Scale.h"
 #include "SelectByVehicleType.h"
 #include "SetupVehicleProduction.h"
+#include "Profiler.h"
 
 #include <algorithm>
 #include <vector>
 
 using std::vector;
-using std::deque;
 using std::pair;
 
 void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const World& world, const Game& game,
-                                                      Move& move, std::deque<std::unique_ptr<Action>>& actions) {
+                                                      Move& move, ActionScheduler& actions) {
+  PROFILE_SCOPE(MAKE_DECISIONS);
   const int current_tick = world.getTickIndex();
 
   if (current_tick == 0) {
+    random_engine_.seed(static_cast<unsigned int>(game.getRandomSeed()));
+
     // Orders initial relative positions of different types of vehicles
     // so that we know in which order we should send them to occupy buildings
     for (const VehicleType& type : kGroundVehicles) {
@@ -38,7 +41,7 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
       (current_tick % kLaunchIterationDuration) / continuous_same_type_launches_duration].second;
 
     // Sets random facility as a destination
-    const Facility& target_facility = facilities[rand() % number_of_facilities];
+    const Facility& target_facility = facilities[random_engine_() % number_of_facilities];
     const Vect destination = Vect(target_facility.getLeft() + game.getFacilityWidth() / 2,
                                   target_facility.getTop() + game.getFacilityHeight() / 2);
 
@@ -46,9 +49,10 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
     // closest to destination
     // and sends them to occupy the facility
     const pair<Vect, Vect> bounds = BoundsForMultipleUnitsClosestToPoint(me, type, destination, kBrigadeSize);
-    actions.push_back(std::make_unique<Select>(bounds.first, bounds.second - bounds.first));
+    actions.StartChain("BrigadeLaunch", ActionPriority::NORMAL);
+    actions.Add(Select(bounds.first, bounds.second - bounds.first));
     const Vect selected_group_position = (bounds.first + bounds.second) / 2;
-    actions.push_back(std::make_unique<GoTo>(destination - selected_group_position));
+    actions.Add(GoTo(destination - selected_group_position));
   }
 
   for (const Facility& facility : facilities) {
@@ -62,7 +66,8 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
         is_facility_mine_[facility_id] = true;
         if (facility.getType() == FacilityType::VEHICLE_FACTORY) {
           // and starts producing tanks there
-          actions.push_back(std::make_unique<SetupVehicleProduction>(facility_id, VehicleType::TANK));
+          actions.StartChain("VehicleProduction", ActionPriority::HIGH);
+          actions.Add(SetupVehicleProduction(facility_id, VehicleType::TANK));
         }
       }
     }
@@ -72,10 +77,10 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
   }
 
   // If initial stage is over (i.e. all ground vehicles were given orders)
-  // and there's not too many planned actions (if too many relocation requests are queued,
-  // deque becomes polluted with meaningless duplicate orders, and they block nuclear strikes in turn)
+  // and there's not too many planned relocations (if too many relocation requests are queued,
+  // their lane becomes polluted with meaningless duplicate orders)
   if (current_tick >= kLaunchIterationDuration * kLaunchIterations &&
-    actions.size() < kMaxDequeSizeToOrderRelocation) {
+    actions.Size(ActionPriority::LOW) < kMaxQueueSizeToOrderRelocation) {
     bool found_starting_point = false;
     Vect starting_point;
     Vect starting_selection_top_left;
@@ -88,20 +93,12 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
       vector<vector<int>> vehicles_outside_facilities_count(
         runtime_constants_->kFragmentsLinearCount,
         vector<int>(runtime_constants_->kFragmentsLinearCount));
-      for (const auto& id_and_vehicle : vehicle_by_id_) {
-        const Vehicle& vehicle = id_and_vehicle.second;
-        if (vehicle.getPlayerId() == me.getId() && !IsAirVehicle(vehicle) &&
-            motionlesness_checker_->IsVehicleMotionless(vehicle, current_tick)) {
-          bool outside_all_facilities = true;
-          for (const Facility& facility : facilities) {
-            if (IsPositionInsideFacility(Vect(vehicle), facility, game)) {
-              outside_all_facilities = false;
-              break;
-            }
-          }
-          if (outside_all_facilities) {
-            const int x = static_cast<int>(vehicle.getX()) / runtime_constants_->kFragmentSideLength;
-            const int y = static_cast<int>(vehicle.getY()) / runtime_constants_->kFragmentSideLength;
+      for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+        if (vehicles_.PlayerId(slot) == me.getId() && !IsAirVehicle(vehicles_.Type(slot)) &&
+            motionlesness_checker_->IsVehicleMotionless(slot, current_tick)) {
+          if (facility_occupancy_->FacilityIndexOf(vehicles_.Id(slot)) == FacilityMap::kNoFacility) {
+            const int x = static_cast<int>(vehicles_.X(slot)) / runtime_constants_->kFragmentSideLength;
+            const int y = static_cast<int>(vehicles_.Y(slot)) / runtime_constants_->kFragmentSideLength;
             vehicles_outside_facilities_count[x][y]++;
           }
         }
@@ -137,12 +134,7 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
       for (size_t i = start_index;; i = (i + 1) % facilities.size()) {
         const Facility& facility = facilities[i];
         if (facility.getOwnerPlayerId() == me.getId()) {
-          int cnt_my_units = 0;
-          for (const auto& id_and_vehicle : vehicle_by_id_) {
-            if (IsPositionInsideFacility(Vect(id_and_vehicle.second), facility, game)) {
-              cnt_my_units++;
-            }
-          }
+          const int cnt_my_units = facility_occupancy_->CountsAt(i).Mine();
 
           // Stops if found ANY troops in a Control Center (can leave immediately)
           // or ENOUGH troops in a Factory
@@ -170,35 +162,53 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
       Vect next_destination;
       Facility best_facility;
       double min_dist = kInfiniteDistance;
+      // The second closest facility of the same kind is an alternative destination
+      bool found_alternative_destination = false;
+      Facility second_best_facility;
+      double second_min_dist = kInfiniteDistance;
+      const auto consider_facility = [&](const Facility& other_facility) {
+        const double dist = (Vect(other_facility) - starting_point).Length();
+        if (dist < min_dist) {
+          second_min_dist = min_dist;
+          second_best_facility = best_facility;
+          found_alternative_destination = found_destination;
+          min_dist = dist;
+          best_facility = other_facility;
+          found_destination = true;
+        }
+        else if (dist < second_min_dist) {
+          second_min_dist = dist;
+          second_best_facility = other_facility;
+          found_alternative_destination = true;
+        }
+      };
 
       // First tries to send them to unoccupied facility
       for (const Facility& other_facility : world.getFacilities()) {
         if (other_facility.getOwnerPlayerId() != me.getId() &&
             other_facility.getOwnerPlayerId() != world.getOpponentPlayer().getId()) {
-          Vect path = Vect(other_facility) - starting_point;
-          if (path.Length() < min_dist) {
-            min_dist = path.Length();
-            best_facility = other_facility;
-            found_destination = true;
-          }
+          consider_facility(other_facility);
         }
       }
       if (!found_destination) {
         // If there is no such facility, considers enemy's facilities
         for (const Facility& other_facility : world.getFacilities()) {
           if (other_facility.getOwnerPlayerId() == world.getOpponentPlayer().getId()) {
-            Vect path = Vect(other_facility) - starting_point;
-            if (path.Length() < min_dist) {
-              min_dist = path.Length();
-              best_facility = other_facility;
-              found_destination = true;
-            }
+            consider_facility(other_facility);
           }
         }
       }
+      const Vect facility_center_shift = Vect(game.getFacilityWidth() / 2, game.getFacilityHeight() / 2);
+      vector<Vect> alternative_destinations;
       if (found_destination) {
-        next_destination = Vect(best_facility.getLeft(), best_facility.getTop()) +
-                           Vect(game.getFacilityWidth() / 2, game.getFacilityHeight() / 2);
+        next_destination = Vect(best_facility.getLeft(), best_facility.getTop()) + facility_center_shift;
+        if (found_alternative_destination) {
+          alternative_destinations.push_back(Vect(second_best_facility.getLeft(), second_best_facility.getTop()) +
+                                             facility_center_shift);
+        }
+        if (cnt_selected_units > kMinTroopsSizeToAttackEnemy) {
+          alternative_destinations.push_back(ClosestEnemyPosition(me, starting_point));
+        }
       }
       else if (cnt_selected_units > kMinTroopsSizeToAttackEnemy) {
         // Decides to attack the enemy if selected troops are strong enough
@@ -207,34 +217,46 @@ void DecisionMakerForGameWithBuildings::MakeDecisions(const Player& me, const Wo
       }
 
       if (found_destination) {
-        actions.push_back(std::make_unique<Select>(starting_selection_top_left, starting_selection_diagonal));
-        if (is_selection_outside_facilities) {
-          // If selected units are standing outside all facilities,
-          // chances are high that they block each other. So let's give them twice more space!
-          actions.push_back(std::make_unique<Scale>(2, starting_point));
+        // ChainPlanner may prefer another destination if the rollouts say so
+        vector<CandidateChain> candidates = {
+          RelocationChain(starting_selection_top_left, starting_selection_diagonal,
+                          is_selection_outside_facilities, next_destination - starting_point)
+        };
+        for (const Vect& destination : alternative_destinations) {
+          candidates.push_back(RelocationChain(starting_selection_top_left, starting_selection_diagonal,
+                                               is_selection_outside_facilities, destination - starting_point));
         }
-        actions.push_back(std::make_unique<GoTo>(next_destination - starting_point));
+        // Relocations are ordered again and again, so a stale one is useless
+        PlanChosenChain(me, "Relocation", ActionPriority::LOW, kRelocateOrdersInterval, candidates, actions);
       }
     }
   }
 
   // Sends helicopters patrolling between facilities
   if (current_tick > kHelicoptersStartTick && current_tick % kHelicoptersSwitchInterval == 0) {
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, runtime_constants_->kWorldSideLength));
+    actions.StartChain("HelicoptersPatrol", ActionPriority::LOW, kHelicoptersSwitchInterval);
+    actions.Add(SelectByVehicleType(VehicleType::HELICOPTER, runtime_constants_->kWorldSideLength));
     const int number_of_facilities = world.getFacilities().size();
-    const Facility& target_facility = world.getFacilities()[rand() % number_of_facilities];
+    const Facility& target_facility = world.getFacilities()[random_engine_() % number_of_facilities];
     const Vect cur_pos = MassCenterForVehiclesByType(me, VehicleType::HELICOPTER);
     const Vect target_pos = Vect(target_facility.getLeft(), target_facility.getTop()) +
                             Vect(game.getFacilityWidth() / 2, game.getFacilityHeight() / 2);
-    actions.push_back(std::make_unique<GoTo>(target_pos - cur_pos));
+    actions.Add(GoTo(target_pos - cur_pos));
   }
 }
 
-bool DecisionMakerForGameWithBuildings::IsPositionInsideFacility(const Vect& pos, const Facility& facility,
-                                                                 const Game& game) const {
-  const Vect top_left = Vect(facility);
-  const Vect bottom_right = top_left + Vect(game.getFacilityWidth(), game.getFacilityHeight());
-  return top_left.x < pos.x && pos.x < bottom_right.x && top_left.y < pos.y && pos.y < bottom_right.y;
+CandidateChain DecisionMakerForGameWithBuildings::RelocationChain(const Vect& selection_top_left,
+                                                                 const Vect& selection_diagonal,
+                                                                 const bool is_selection_outside_facilities,
+                                                                 const Vect& shift) const {
+  CandidateChain chain = { Select(selection_top_left, selection_diagonal) };
+  if (is_selection_outside_facilities) {
+    // If selected units are standing outside all facilities,
+    // chances are high that they block each other. So let's give them twice more space!
+    chain.push_back(Scale(2, selection_top_left + selection_diagonal / 2));
+  }
+  chain.push_back(GoTo(shift));
+  return chain;
 }
 
 double DecisionMakerForGameWithBuildings::DistanceBetweenFacilities(const Facility& facility1,
@@ -243,9 +265,9 @@ double DecisionMakerForGameWithBuildings::DistanceBetweenFacilities(const Facili
   return path.Length();
 }
 
-bool DecisionMakerForGameWithBuildings::IsAirVehicle(const Vehicle& vehicle) const {
-  for (const VehicleType& vehicle_type : kAirVehicles) {
-    if (vehicle_type == vehicle.getType()) {
+bool DecisionMakerForGameWithBuildings::IsAirVehicle(const VehicleType& vehicle_type) const {
+  for (const VehicleType& air_vehicle_type : kAirVehicles) {
+    if (air_vehicle_type == vehicle_type) {
       return true;
     }
   }
@@ -257,33 +279,23 @@ pair<Vect, Vect> DecisionMakerForGameWithBuildings::BoundsForMultipleUnitsCloses
     const VehicleType& vehicle_type,
     const Vect& anchor_point,
     size_t size) {
-  vector<pair<double, long long>> potential_group_members; // {distance to anchor point; ID}
-
-  // add my vehicles of desired type that haven't moved yet to the above-defined vector
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    if (vehicle.getPlayerId() == me.getId() && vehicle.getType() == vehicle_type &&
-      vehicle_coordinates_update_tick_by_id_[vehicle.getId()] == 0) {
-      potential_group_members.emplace_back((Vect(vehicle) - anchor_point).Length(), vehicle.getId());
-    }
-  }
-
-  // chooses <size> closest vehicles (or less if vector size is smaller) 
-  size = std::min(size, potential_group_members.size());
-  std::sort(potential_group_members.begin(), potential_group_members.end());
-  potential_group_members.resize(size);
+  // chooses <size> closest vehicles of desired type that haven't moved yet (or less if there are not enough of them)
+  const long long my_id = me.getId();
+  spatial_grid_->KNearest(anchor_point, size, [&](const size_t slot) {
+    return vehicles_.PlayerId(slot) == my_id && vehicles_.Type(slot) == vehicle_type && vehicles_.MoveTick(slot) == 0;
+  }, brigade_members_);
 
   // initializes bounds for the rectangle
   double min_x = runtime_constants_->kWorldSideLength, max_x = 0;
   double min_y = runtime_constants_->kWorldSideLength, max_y = 0;
 
   // updates bounds
-  for (const auto& potential_group_member : potential_group_members) {
-    const Vect vehicle_position = Vect(vehicle_by_id_[potential_group_member.second]);
-    min_x = std::min(min_x, vehicle_position.x);
-    max_x = std::max(max_x, vehicle_position.x);
-    min_y = std::min(min_y, vehicle_position.y);
-    max_y = std::max(max_y, vehicle_position.y);
+  for (const auto& brigade_member : brigade_members_) {
+    const size_t slot = brigade_member.second;
+    min_x = std::min(min_x, vehicles_.X(slot));
+    max_x = std::max(max_x, vehicles_.X(slot));
+    min_y = std::min(min_y, vehicles_.Y(slot));
+    max_y = std::max(max_y, vehicles_.Y(slot));
   }
 
   return std::make_pair(Vect(min_x, min_y), Vect(max_x, max_y));
@@ -3,24 +3,30 @@
 #define _DECISION_MAKER_FOR_GAME_WITH_BUILDINGS_H_
 
 #include "DecisionMaker.h"
+#include <map>
 #include <memory>
+#include <random>
 
 class DecisionMakerForGameWithBuildings : public DecisionMaker {
  public:  
   void MakeDecisions(const Player& me, const World& world, const Game& game,
-                     Move& move, std::deque<std::unique_ptr<Action>>& actions) override;
-
- private:
-  bool IsPositionInsideFacility(const Vect& pos, const Facility& facility, const Game& game) const;
-  double DistanceBetweenFacilities(const Facility& facility1, const Facility& facility2) const;
-  bool IsAirVehicle(const Vehicle& vehicle) const;
+                     Move& move, ActionScheduler& actions) override;
 
+ protected:
   // Finds bounding rectangle for <size+> vehicles of specified type that
   // haven't moved yet and are as close as possible to a specified anchor point.
   // Returns coordinates of the top left and bottom right corners.
   std::pair<Vect, Vect> BoundsForMultipleUnitsClosestToPoint(const Player& me, const VehicleType& vehicle_type,
                                                              const Vect& anchor_point, size_t size);
 
+ private:
+  double DistanceBetweenFacilities(const Facility& facility1, const Facility& facility2) const;
+  bool IsAirVehicle(const VehicleType& vehicle_type) const;
+
+  // Selects the rectangle (spreading the vehicles if they stand outside facilities) and moves it by <shift>
+  CandidateChain RelocationChain(const Vect& selection_top_left, const Vect& selection_diagonal,
+                                 const bool is_selection_outside_facilities, const Vect& shift) const;
+
   // Constants describing strategy's initial stage timeline (sending brigades to occupy buildings).
   // Here's a brief overview of the initial stage: it consists of 3 similar iterations.
   // On each iteration, we consider each type of ground vehicles one by one.
@@ -33,7 +39,7 @@ class DecisionMakerForGameWithBuildings : public DecisionMaker {
   const int kLaunchInterval = 40;
   const int kBrigadeSize = 10;
 
-  const size_t kMaxDequeSizeToOrderRelocation = 5;
+  const size_t kMaxQueueSizeToOrderRelocation = 5;
 
   const int kRelocateOrdersInterval = 100;
   const int kMinTroopsToTouchOutsideFacilities = 5;
@@ -45,6 +51,12 @@ class DecisionMakerForGameWithBuildings : public DecisionMaker {
 
   std::map<long long, bool> is_facility_mine_;
 
+  // {squared distance to anchor point; slot} of the vehicles chosen by BoundsForMultipleUnitsClosestToPoint
+  std::vector<std::pair<double, size_t>> brigade_members_;
+
+  // Picks random facilities; seeded with the game's random seed so that replays are reproducible
+  std::mt19937 random_engine_;
+
   // Helps to determine initial relative positions of different types of vehicles
   std::vector<std::pair<std::pair<double, double>, VehicleType>> vehicle_type_representatives_positions_;
 };
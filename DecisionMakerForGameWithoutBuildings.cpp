@@ -7,6 +7,7 @@
 #include "AddToSelectionByVehicleType.h"
 #include "Scale.h"
 #include "Rotate.h"
+#include "Profiler.h"
 
 #include <algorithm>
 
@@ -18,7 +19,8 @@ DecisionMakerForGameWithoutBuildings::DecisionMakerForGameWithoutBuildings() {
 }
 
 void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const World& world, const Game& game,
-                                                         Move& move, std::deque<std::unique_ptr<Action>>& actions) {
+                                                         Move& move, ActionScheduler& actions) {
+  PROFILE_SCOPE(MAKE_DECISIONS);
   // advances motionless vehicles to the next regrouping stage
   MakeRegroupingStageTransitions();
 
@@ -40,10 +42,12 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
       std::swap(fighter_destination, helicopter_destination);
       isHelicoptersDestinationAboveFighters = true;
     }
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::FIGHTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<GoTo>(fighter_destination - fighter_mass_center));
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<GoTo>(helicopter_destination - helicopter_mass_center));
+    actions.StartChain("InitialAirPlacement", ActionPriority::NORMAL);
+    actions.Add(SelectByVehicleType(VehicleType::FIGHTER, RelToWorld(1.0)));
+    actions.Add(GoTo(fighter_destination - fighter_mass_center));
+    actions.StartChain("InitialAirPlacement", ActionPriority::NORMAL);
+    actions.Add(SelectByVehicleType(VehicleType::HELICOPTER, RelToWorld(1.0)));
+    actions.Add(GoTo(helicopter_destination - helicopter_mass_center));
 
     // Determines vertical order of different types of ground vehicles,
     // so that they won't get stuck while regrouping
@@ -60,8 +64,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
     for (size_t i = 0; i < order.size(); i++) {
       const double y = order[i].first;
       const VehicleType ground_vehicle_type = order[i].second;
-      actions.push_back(std::make_unique<SelectByVehicleType>(ground_vehicle_type, RelToWorld(1.0)));
-      actions.push_back(std::make_unique<GoTo>(
+      actions.StartChain("InitialGroundPlacement", ActionPriority::NORMAL);
+      actions.Add(SelectByVehicleType(ground_vehicle_type, RelToWorld(1.0)));
+      actions.Add(GoTo(
         Vect(0, RelToWorld(kRelativeLowestGroundDestination - kRelativeGroundStep * i) - y)));
     }
   }
@@ -70,7 +75,7 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
   if (motionlesness_checker_->AreAllVehiclesOfTypeMotionless(VehicleType::HELICOPTER) &&
       air_crew_state_ == INITIAL) {
     // Prevents air vehicles from switching regrouping stages twice in a row
-    FakeLastUpdatedTickForMyVehiclesOfTypes(me, current_tick, { VehicleType::HELICOPTER });
+    motionlesness_checker_->MarkTypesAsMoving({ VehicleType::HELICOPTER }, current_tick);
     // Gives new orders to air vehicles
     switch (regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)]) {
       case READY_FOR_SHIFT_BY_X: {
@@ -79,8 +84,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         for (int i = 0; i < 2; i++) {
           const Vect center = RelToWorld(kRelativeAirDestinations[i]);
           const Vect diagonal = kUnitVector * RelToWorld(kRelativeGroupSide);
-          actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-          actions.push_back(std::make_unique<Scale>(2, center));
+          actions.StartChain("AirRegrouping", ActionPriority::NORMAL);
+          actions.Add(Select(center - diagonal / 2, diagonal));
+          actions.Add(Scale(2, center));
         }
         regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)] = SCALING;
         break;
@@ -88,20 +94,22 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
 
       case READY_FOR_ADJUSTMENT_BY_X: {
         // Shifts helicopters a bit so that they can fly into the gaps between fighters
-        actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, RelToWorld(1.0)));
-        actions.push_back(std::make_unique<GoTo>(RelToWorld(kRelativeGroupAdjustment)));
+        actions.StartChain("AirRegrouping", ActionPriority::NORMAL);
+        actions.Add(SelectByVehicleType(VehicleType::HELICOPTER, RelToWorld(1.0)));
+        actions.Add(GoTo(RelToWorld(kRelativeGroupAdjustment)));
         regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)] = ADJUSTMENT_BY_X;
         break;
       }
 
       case READY_FOR_COLLAPSING: {
         // Moves helicopters into the gaps between fighters
-        actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, RelToWorld(1.0)));
+        actions.StartChain("AirRegrouping", ActionPriority::NORMAL);
+        actions.Add(SelectByVehicleType(VehicleType::HELICOPTER, RelToWorld(1.0)));
         Vect diff = RelToWorld(kRelativeAirDestinations[0] - kRelativeAirDestinations[1]);
         if (!isHelicoptersDestinationAboveFighters) {
           diff *= -1;
         }
-        actions.push_back(std::make_unique<GoTo>(diff));
+        actions.Add(GoTo(diff));
         regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)] = COLLAPSING;
         break;
       }
@@ -111,8 +119,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         const size_t center_index = isHelicoptersDestinationAboveFighters ? 0 : 1;
         const Vect center = RelToWorld(kRelativeAirDestinations[center_index]);
         const Vect diagonal = kUnitVector * RelToWorld(kRelativeGroupSide);
-        actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-        actions.push_back(std::make_unique<Rotate>(kRotationAngle, center));
+        actions.StartChain("AirRegrouping", ActionPriority::NORMAL);
+        actions.Add(Select(center - diagonal / 2, diagonal));
+        actions.Add(Rotate(kRotationAngle, center));
         regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)] = ROTATING;
         break;
       }
@@ -122,8 +131,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         const size_t center_index = isHelicoptersDestinationAboveFighters ? 0 : 1;
         const Vect center = RelToWorld(kRelativeAirDestinations[center_index]);
         const Vect diagonal = kUnitVector * RelToWorld(kRelativeGroupSide);
-        actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-        actions.push_back(std::make_unique<Scale>(kDescalingRatio, center));
+        actions.StartChain("AirRegrouping", ActionPriority::NORMAL);
+        actions.Add(Select(center - diagonal / 2, diagonal));
+        actions.Add(Scale(kDescalingRatio, center));
         regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::HELICOPTER)] = DESCALING;
       }
 
@@ -137,22 +147,35 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
   if (air_crew_state_ == TO_ENEMY &&
       DistanceBetweenMyAirVehiclesAndEnemyVehicles(me) < game.getFighterAerialAttackRange()) {
     // If some of my aerial vehicles are close enough to attack the enemy, starts retreating
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<AddToSelectionByVehicleType>(VehicleType::FIGHTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<GoToWithSpeedLimit>(kUnitVector * RelToWorld(kRelativeRetreat),
-                                                           game.getHelicopterSpeed()));
+    // (by default, diagonally towards my corner; alternatively, farther or straight away from the closest enemy)
+    const Vect retreat = kUnitVector * RelToWorld(kRelativeRetreat);
+    vector<CandidateChain> candidates = {
+      AirCrewChain(GoToWithSpeedLimit(retreat, game.getHelicopterSpeed())),
+      AirCrewChain(GoToWithSpeedLimit(retreat * kAirRetreatAlternativeFactor, game.getHelicopterSpeed()))
+    };
+    const Vect air_center = MassCenterForVehiclesByTypes(me, { VehicleType::HELICOPTER, VehicleType::FIGHTER });
+    Vect away_from_enemy = air_center - ClosestEnemyPosition(me, air_center);
+    if (away_from_enemy.Length() > kSmallEps) {
+      away_from_enemy.Normalize();
+      candidates.push_back(AirCrewChain(GoToWithSpeedLimit(away_from_enemy * retreat.Length(),
+                                                           game.getHelicopterSpeed())));
+    }
+    PlanChosenChain(me, "AirRetreat", ActionPriority::HIGH, ActionChain::kNoDeadline, candidates, actions);
     air_crew_state_ = FROM_ENEMY;
   }
   if (air_crew_state_ == FROM_ENEMY &&
       DistanceBetweenMyAirVehiclesAndEnemyVehicles(me) > game.getFighterVisionRange()) {
     // If none of my aerial vehicles see the enemy, starts approaching
     // to the spot with maximum cumulative value
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::HELICOPTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<AddToSelectionByVehicleType>(VehicleType::FIGHTER, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<GoToWithSpeedLimit>(
-      nuclear_attack_handler_->FindSquareWithLargestPotentialForNuclearStrike(me) -
-      MassCenterForVehiclesByTypes(me, { VehicleType::HELICOPTER, VehicleType::FIGHTER }),
-      game.getHelicopterSpeed()));
+    // (alternatively, only part of the way there or straight to the closest enemy)
+    const Vect air_center = MassCenterForVehiclesByTypes(me, { VehicleType::HELICOPTER, VehicleType::FIGHTER });
+    const Vect approach = nuclear_attack_handler_->FindSquareWithLargestPotentialForNuclearStrike(me) - air_center;
+    const vector<CandidateChain> candidates = {
+      AirCrewChain(GoToWithSpeedLimit(approach, game.getHelicopterSpeed())),
+      AirCrewChain(GoToWithSpeedLimit(approach * kAirApproachAlternativeFactor, game.getHelicopterSpeed())),
+      AirCrewChain(GoToWithSpeedLimit(ClosestEnemyPosition(me, air_center) - air_center, game.getHelicopterSpeed()))
+    };
+    PlanChosenChain(me, "AirApproach", ActionPriority::HIGH, ActionChain::kNoDeadline, candidates, actions);
     air_crew_state_ = TO_ENEMY;
   }
 
@@ -160,14 +183,15 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
   const RegroupingStage arrv_stage = regrouping_stage_by_vehicle_type_[static_cast<size_t>(VehicleType::ARRV)];
   if (AllMyGroundVehiclesOnSpecificRegroupingStage(arrv_stage) &&
       motionlesness_checker_->AreAllVehiclesOfTypesMotionless(kGroundVehicles)) {
-    FakeLastUpdatedTickForMyGroundVehicles(me, current_tick);
+    motionlesness_checker_->MarkTypesAsMoving(kGroundVehicles, current_tick);
     switch (arrv_stage) {
       case READY_FOR_SHIFT_BY_X: {
         // Moves ground vehicles horizontally so that they end up directly below each other
         for (const VehicleType& vehicle_type : kGroundVehicles) {
-          actions.push_back(std::make_unique<SelectByVehicleType>(vehicle_type, RelToWorld(1.0)));
+          actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+          actions.Add(SelectByVehicleType(vehicle_type, RelToWorld(1.0)));
           const Vect mass_center = MassCenterForVehiclesByType(me, vehicle_type);
-          actions.push_back(std::make_unique<GoTo>(Vect(RelToWorld(kRelativeGroundX) - mass_center.x, 0)));
+          actions.Add(GoTo(Vect(RelToWorld(kRelativeGroundX) - mass_center.x, 0)));
           regrouping_stage_by_vehicle_type_[static_cast<int>(vehicle_type)] = SHIFT_BY_X;
         }
         break;
@@ -177,8 +201,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Scales ground vehicle groups, so that they can infiltrate each other
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = SCALING;
-          actions.push_back(std::make_unique<SelectByVehicleType>(vehicle_type, RelToWorld(1.0)));
-          actions.push_back(std::make_unique<Scale>(kGroundVehicles.size(), MassCenterForVehiclesByType(me, vehicle_type)));
+          actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+          actions.Add(SelectByVehicleType(vehicle_type, RelToWorld(1.0)));
+          actions.Add(Scale(kGroundVehicles.size(), MassCenterForVehiclesByType(me, vehicle_type)));
         }
         break;
       }
@@ -187,11 +212,12 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Shift ground vehicle groups, so that they can infiltrate each other by moving vertically
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = ADJUSTMENT_BY_X;
-          actions.push_back(std::make_unique<SelectByVehicleType>(vehicle_type, RelToWorld(1.0)));
+          actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+          actions.Add(SelectByVehicleType(vehicle_type, RelToWorld(1.0)));
           const Vect adjustment = RelToWorld(kRelativeGroupAdjustment) *
             std::max(0, int(vehicle_type) - 2); // 0 for VehicleType(0), 1 for VehicleType(3) and 2 for VehicleType(4)
                                                 // because VehicleType(1) and VehicleType(2) stand for air vehicles          
-          actions.push_back(std::make_unique<GoTo>(adjustment));
+          actions.Add(GoTo(adjustment));
         }
         break;
       }
@@ -200,9 +226,10 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Merges groups of ground vehicles
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = COLLAPSING;
-          actions.push_back(std::make_unique<SelectByVehicleType>(vehicle_type, RelToWorld(1.0)));
+          actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+          actions.Add(SelectByVehicleType(vehicle_type, RelToWorld(1.0)));
           const Vect mass_center = MassCenterForVehiclesByType(me, vehicle_type);
-          actions.push_back(std::make_unique<GoTo>(Vect(0, RelToWorld(kRelativeGroundY) - mass_center.y)));
+          actions.Add(GoTo(Vect(0, RelToWorld(kRelativeGroundY) - mass_center.y)));
         }
         break;
       }
@@ -211,8 +238,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Rotates groups of ground vehicles so that descaling will be more effective
         const Vect center = RelToWorld(Vect(kRelativeGroundX, kRelativeGroundY));
         const Vect diagonal = kUnitVector * RelToWorld(kRelativeScaledGroupSide);
-        actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-        actions.push_back(std::make_unique<Rotate>(kRotationAngle, center));
+        actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+        actions.Add(Select(center - diagonal / 2, diagonal));
+        actions.Add(Rotate(kRotationAngle, center));
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = ROTATING;
         }
@@ -223,8 +251,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Makes group of ground vehicles more dense
         const Vect center = RelToWorld(Vect(kRelativeGroundX, kRelativeGroundY));
         const Vect diagonal = kUnitVector * RelToWorld(kRelativeScaledGroupSide);
-        actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-        actions.push_back(std::make_unique<Scale>(kDescalingRatio, center));
+        actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+        actions.Add(Select(center - diagonal / 2, diagonal));
+        actions.Add(Scale(kDescalingRatio, center));
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = DESCALING;
         }
@@ -235,8 +264,9 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
         // Rotates group of ground vehicles by 90 degrees so that it turns the most dense side to the enemy
         const Vect center = RelToWorld(Vect(kRelativeGroundX, kRelativeGroundY));
         const Vect diagonal = kUnitVector * RelToWorld(kRelativeScaledGroupSide);
-        actions.push_back(std::make_unique<Select>(center - diagonal / 2, diagonal));
-        actions.push_back(std::make_unique<Rotate>(kRotationAngle * 2, center));
+        actions.StartChain("GroundRegrouping", ActionPriority::NORMAL);
+        actions.Add(Select(center - diagonal / 2, diagonal));
+        actions.Add(Rotate(kRotationAngle * 2, center));
         for (const VehicleType& vehicle_type : kGroundVehicles) {
           regrouping_stage_by_vehicle_type_[static_cast<size_t>(vehicle_type)] = READY_FOR_ATTACK;
         }
@@ -248,15 +278,21 @@ void DecisionMakerForGameWithoutBuildings::MakeDecisions(const Player& me, const
   // If we are not winning and regrouping is over for ground vehicles, brings them into attack
   if (current_tick > game.getTickCount() / 4 && current_tick % kKillerGroupUpdateFrequency == 0 &&
       me.getScore() <= world.getOpponentPlayer().getScore()) {
-    actions.push_back(std::make_unique<SelectByVehicleType>(VehicleType::ARRV, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<AddToSelectionByVehicleType>(VehicleType::TANK, RelToWorld(1.0)));
-    actions.push_back(std::make_unique<AddToSelectionByVehicleType>(VehicleType::IFV, RelToWorld(1.0)));
     const Vect source = MassCenterForGroundVehicles(me);
     const Vect destination = ClosestEnemyPosition(me, source);
     Vect direction = destination - source;
     direction.Normalize();
     direction *= RelToWorld(kKillerGroupStep);
-    actions.push_back(std::make_unique<GoToWithSpeedLimit>(direction, kGroundVehiclesSpeedLimit));
+    // Steps towards the closest enemy; alternatively, makes a longer step, turns aside or closes ranks
+    const vector<CandidateChain> candidates = {
+      GroundArmyChain(GoToWithSpeedLimit(direction, kGroundVehiclesSpeedLimit)),
+      GroundArmyChain(GoToWithSpeedLimit(direction * kKillerGroupAlternativeStepFactor, kGroundVehiclesSpeedLimit)),
+      GroundArmyChain(GoToWithSpeedLimit(direction.Rotated(kKillerGroupTurnAngle), kGroundVehiclesSpeedLimit)),
+      GroundArmyChain(GoToWithSpeedLimit(direction.Rotated(-kKillerGroupTurnAngle), kGroundVehiclesSpeedLimit)),
+      GroundArmyChain(Scale(kKillerGroupCompactionRatio, source))
+    };
+    // The order is given again every kKillerGroupUpdateFrequency ticks, so a stale one is dropped
+    PlanChosenChain(me, "KillerGroup", ActionPriority::NORMAL, kKillerGroupUpdateFrequency, candidates, actions);
   }
 }
 
@@ -320,25 +356,47 @@ double DecisionMakerForGameWithoutBuildings::DistanceBetweenMyAirVehiclesAndEnem
                           vector<int>(runtime_constants_->kFragmentsLinearCount));
 
   // Considers all my aerial vehicles
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    const VehicleType& type = vehicle.getType();
+  const long long my_id = me.getId();
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+    const VehicleType type = vehicles_.Type(slot);
     if ((type == VehicleType::FIGHTER || type == VehicleType::HELICOPTER) &&
-        vehicle.getPlayerId() == me.getId()) {
+        vehicles_.PlayerId(slot) == my_id) {
       // And maps them onto square fragments
-      const Vect pos = Vect(vehicle);
+      const Vect pos = vehicles_.Position(slot);
       cnt[size_t(pos.x / runtime_constants_->kFragmentSideLength)]
         [size_t(pos.y / runtime_constants_->kFragmentSideLength)]++;
     }
   }
 
+  if (!cpu_governor_->IsAirDistanceRefined()) {
+    // Measures the distance only from the densest fragment (a single search for the closest enemy)
+    int densest_fragment_cnt = 0;
+    Vect densest_fragment_position;
+    for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+      const VehicleType vehicle_type = vehicles_.Type(slot);
+      if ((vehicle_type == VehicleType::FIGHTER || vehicle_type == VehicleType::HELICOPTER) &&
+          vehicles_.PlayerId(slot) == my_id) {
+        const Vect pos = vehicles_.Position(slot);
+        const int fragment_cnt = cnt[size_t(pos.x / runtime_constants_->kFragmentSideLength)]
+                                    [size_t(pos.y / runtime_constants_->kFragmentSideLength)];
+        if (fragment_cnt > densest_fragment_cnt) {
+          densest_fragment_cnt = fragment_cnt;
+          densest_fragment_position = pos;
+        }
+      }
+    }
+    if (densest_fragment_cnt >= kMainAirCrewMinUnits) {
+      min_distance = (ClosestEnemyPosition(me, densest_fragment_position) - densest_fragment_position).Length();
+    }
+    return min_distance;
+  }
+
   // Considers all my aerial vehicles again
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    const VehicleType& vehicle_type = vehicle.getType();
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+    const VehicleType vehicle_type = vehicles_.Type(slot);
     if ((vehicle_type == VehicleType::FIGHTER || vehicle_type == VehicleType::HELICOPTER) &&
-        vehicle.getPlayerId() == me.getId()) {
-      const Vect pos = Vect(vehicle);
+        vehicles_.PlayerId(slot) == my_id) {
+      const Vect pos = vehicles_.Position(slot);
       const unsigned int fragment_x = int(pos.x / runtime_constants_->kFragmentSideLength);
       const unsigned int fragment_y = int(pos.y / runtime_constants_->kFragmentSideLength);
       // If it looks like this unit belongs to the main (largest) group of aerial vehicles,
@@ -354,38 +412,17 @@ double DecisionMakerForGameWithoutBuildings::DistanceBetweenMyAirVehiclesAndEnem
   return min_distance;
 }
 
-void DecisionMakerForGameWithoutBuildings::FakeLastUpdatedTickForMyVehiclesOfTypes(
-    const Player& me, const int current_tick,
-    const std::vector<VehicleType>& types) {
-  // Consider all my vehicles matching one of the <types>
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-    if (vehicle.getPlayerId() == me.getId()) {
-      const long long id = id_and_vehicle.first;
-      bool matches_type = false;
-      for (const auto& type : types) {
-        if (vehicle.getType() == type) {
-          matches_type = true;
-          break;
-        }
-      }
-      if (matches_type) {
-        // Tell this vehicle that its coordinate was just updated (even though most likely it wasn't)
-        update_tick_by_vehicle_id_[id] = current_tick;
-        vehicle_coordinates_update_tick_by_id_[id] = current_tick;
-      }
-    }
-  }
-}
-
-void DecisionMakerForGameWithoutBuildings::FakeLastUpdatedTickForMyGroundVehicles(
-    const Player& me, const int current_tick) {
-  FakeLastUpdatedTickForMyVehiclesOfTypes(me, current_tick, kGroundVehicles);
+CandidateChain DecisionMakerForGameWithoutBuildings::AirCrewChain(const Action& order) const {
+  return CandidateChain{ SelectByVehicleType(VehicleType::HELICOPTER, RelToWorld(1.0)),
+                         AddToSelectionByVehicleType(VehicleType::FIGHTER, RelToWorld(1.0)),
+                         order };
 }
 
-void DecisionMakerForGameWithoutBuildings::FakeLastUpdatedTickForAllMyVehicles(
-    const Player& me, const int current_tick) {
-  FakeLastUpdatedTickForMyVehiclesOfTypes(me, current_tick, kAllVehicles);
+CandidateChain DecisionMakerForGameWithoutBuildings::GroundArmyChain(const Action& order) const {
+  return CandidateChain{ SelectByVehicleType(VehicleType::ARRV, RelToWorld(1.0)),
+                         AddToSelectionByVehicleType(VehicleType::TANK, RelToWorld(1.0)),
+                         AddToSelectionByVehicleType(VehicleType::IFV, RelToWorld(1.0)),
+                         order };
 }
 
 double DecisionMakerForGameWithoutBuildings::RelToWorld(const double x) const {
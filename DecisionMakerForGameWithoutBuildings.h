@@ -9,7 +9,11 @@ class DecisionMakerForGameWithoutBuildings : public DecisionMaker {
  public:
   DecisionMakerForGameWithoutBuildings();
   void MakeDecisions(const Player& me, const World& world, const Game& game,
-                     Move& move, std::deque<std::unique_ptr<Action>>& actions) override;
+                     Move& move, ActionScheduler& actions) override;
+
+ protected:
+  // gives approximate result!
+  double DistanceBetweenMyAirVehiclesAndEnemyVehicles(const Player& me) const;
 
  private:
   // Used separately for both ground and aerial vehicles
@@ -45,17 +49,10 @@ class DecisionMakerForGameWithoutBuildings : public DecisionMaker {
   bool AllMyGroundVehiclesOnSpecificRegroupingStage(const RegroupingStage& stage) const;
   bool AllMyAirVehiclesOnSpecificRegroupingStage(const RegroupingStage& stage) const;
 
-  // gives approximate result!
-  double DistanceBetweenMyAirVehiclesAndEnemyVehicles(const Player& me) const;
-
-  // Imitates that a certain group of vehicles has just moved.
-  // This function is useful when a group received an order but it is queued,
-  // and therefore that group can still be treated as motionless
-  // which is undesirable for Regrouping Stage Transitions
-  void FakeLastUpdatedTickForMyVehiclesOfTypes(const Player& me, const int current_tick,
-                                               const std::vector<VehicleType>& types);
-  void FakeLastUpdatedTickForMyGroundVehicles(const Player& me, const int current_tick);
-  void FakeLastUpdatedTickForAllMyVehicles(const Player& me, const int current_tick);
+  // Chains moving the whole air crew (helicopters with fighters) and the whole ground army (ARRVs, tanks and IFVs)
+  // with the given order
+  CandidateChain AirCrewChain(const Action& order) const;
+  CandidateChain GroundArmyChain(const Action& order) const;
 
   // Maps relative coordinates (from 0.0 to 1.0) onto World coordinate system
   double RelToWorld(const double x) const;
@@ -78,6 +75,13 @@ class DecisionMakerForGameWithoutBuildings : public DecisionMaker {
   const double kRelativeRetreat = -0.1;
   const double kKillerGroupStep = 0.05;
 
+  // Alternatives to the orders of the approach-retreat strategy and the killer group, compared by ChainPlanner
+  const double kAirRetreatAlternativeFactor = 2; // a retreat this many times farther
+  const double kAirApproachAlternativeFactor = 0.5; // an approach covering only this part of the way
+  const double kKillerGroupAlternativeStepFactor = 2;
+  const double kKillerGroupTurnAngle = 0.5; // ~ 30 degrees to either side of the closest enemy
+  const double kKillerGroupCompactionRatio = 0.75; // closes ranks instead of stepping forward
+
   const int kKillerGroupUpdateFrequency = 100; // when all ground vehicles are sent into attack,
                                                // its destination should be updated regularly
   const double kGroundVehiclesSpeedLimit = 0.15; // when all ground vehicles are sent into attack,
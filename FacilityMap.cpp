@@ -0,0 +1,62 @@
+#include "FacilityMap.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace model;
+
+FacilityMap::FacilityMap(const std::vector<Facility>& facilities, const Game& game,
+                         const double world_side_length, const double cell_side_length)
+    : facility_size_(game.getFacilityWidth(), game.getFacilityHeight()),
+      cell_side_length_(cell_side_length),
+      cells_linear_count_(static_cast<size_t>(std::ceil(world_side_length / cell_side_length))),
+      facility_by_cell_(cells_linear_count_ * cells_linear_count_, kNoFacility) {
+  for (size_t i = 0; i < facilities.size(); i++) {
+    const Vect top_left = Vect(facilities[i]);
+    top_left_corners_.push_back(top_left);
+    const Vect bottom_right = top_left + facility_size_;
+    // Cells intersecting the open rectangle of the facility
+    const size_t x_begin = CellIndex(top_left.x);
+    const size_t y_begin = CellIndex(top_left.y);
+    const size_t x_end = std::min(cells_linear_count_,
+                                  static_cast<size_t>(std::ceil(bottom_right.x / cell_side_length_)));
+    const size_t y_end = std::min(cells_linear_count_,
+                                  static_cast<size_t>(std::ceil(bottom_right.y / cell_side_length_)));
+    for (size_t x = x_begin; x < x_end; x++) {
+      for (size_t y = y_begin; y < y_end; y++) {
+        std::int16_t& cell = facility_by_cell_[x * cells_linear_count_ + y];
+        cell = cell == kNoFacility ? static_cast<std::int16_t>(i) : kSeveralFacilities;
+      }
+    }
+  }
+}
+
+int FacilityMap::FacilityIndexAt(const Vect& position) const {
+  const std::int16_t cell = facility_by_cell_[CellIndex(position.x) * cells_linear_count_ + CellIndex(position.y)];
+  if (cell == kNoFacility) {
+    return kNoFacility;
+  }
+  if (cell != kSeveralFacilities) {
+    return IsInsideFacility(position, static_cast<size_t>(cell)) ? cell : kNoFacility;
+  }
+  for (size_t i = 0; i < top_left_corners_.size(); i++) {
+    if (IsInsideFacility(position, i)) {
+      return static_cast<int>(i);
+    }
+  }
+  return kNoFacility;
+}
+
+bool FacilityMap::IsInsideFacility(const Vect& position, const size_t facility_index) const {
+  const Vect& top_left = top_left_corners_[facility_index];
+  const Vect bottom_right = top_left + facility_size_;
+  return top_left.x < position.x && position.x < bottom_right.x &&
+         top_left.y < position.y && position.y < bottom_right.y;
+}
+
+size_t FacilityMap::CellIndex(const double coordinate) const {
+  if (coordinate <= 0) {
+    return 0;
+  }
+  return std::min(cells_linear_count_ - 1, static_cast<size_t>(coordinate / cell_side_length_));
+}
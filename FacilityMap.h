@@ -0,0 +1,40 @@
+#pragma once
+#ifndef _FACILITY_MAP_H_
+#define _FACILITY_MAP_H_
+
+#include "Strategy.h"
+#include "Vect.h"
+#include <cstdint>
+#include <vector>
+
+// Facilities never move, so they are rasterized once into a grid covering the whole world:
+// each cell stores the index of the facility (in model::World::getFacilities()) it intersects.
+// A lookup reads the cell and then checks the position against that single facility,
+// so the answer is exact for any cell size (cells aligned with facility borders give the fastest one).
+class FacilityMap {
+ public:
+  static const int kNoFacility = -1;
+
+  FacilityMap(const std::vector<model::Facility>& facilities, const model::Game& game,
+              const double world_side_length, const double cell_side_length);
+
+  // Index of the facility which contains the position (strictly inside) or kNoFacility
+  int FacilityIndexAt(const Vect& position) const;
+
+  size_t FacilitiesCount() const { return top_left_corners_.size(); }
+
+ private:
+  // Cell intersecting more than one facility, positions in it are checked against each facility
+  static const std::int16_t kSeveralFacilities = -2;
+
+  bool IsInsideFacility(const Vect& position, const size_t facility_index) const;
+  size_t CellIndex(const double coordinate) const;
+
+  std::vector<Vect> top_left_corners_;
+  const Vect facility_size_;
+  const double cell_side_length_;
+  const size_t cells_linear_count_;
+  std::vector<std::int16_t> facility_by_cell_;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#include "FacilityOccupancy.h"
+
+using namespace model;
+
+const int FacilityOccupancy::kNotCounted;
+
+FacilityOccupancy::FacilityOccupancy(const VehicleStore& vehicles, std::shared_ptr<const FacilityMap> facility_map,
+                                     const long long my_id)
+    : vehicles_(vehicles),
+      facility_map_(facility_map),
+      my_id_(my_id),
+      counts_by_facility_(facility_map_->FacilitiesCount()) {}
+
+void FacilityOccupancy::Insert(const long long vehicle_id) {
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= facility_by_id_.size()) {
+    facility_by_id_.resize(id_index * 2 + 1, kNotCounted);
+  }
+  if (facility_by_id_[id_index] != kNotCounted) {
+    // The vehicle is already known (e.g. it has been reported as a new one twice)
+    Move(vehicle_id);
+    return;
+  }
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  const int facility_index = facility_map_->FacilityIndexAt(vehicles_.Position(slot));
+  Account(slot, facility_index, 1);
+  facility_by_id_[id_index] = facility_index;
+}
+
+void FacilityOccupancy::Move(const long long vehicle_id) {
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  const int facility_index = facility_map_->FacilityIndexAt(vehicles_.Position(slot));
+  int& counted_index = facility_by_id_[static_cast<size_t>(vehicle_id)];
+  if (counted_index != facility_index) {
+    Account(slot, counted_index, -1);
+    Account(slot, facility_index, 1);
+    counted_index = facility_index;
+  }
+}
+
+void FacilityOccupancy::Remove(const long long vehicle_id) {
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= facility_by_id_.size() || facility_by_id_[id_index] == kNotCounted) {
+    return;
+  }
+  Account(vehicles_.SlotById(vehicle_id), facility_by_id_[id_index], -1);
+  facility_by_id_[id_index] = kNotCounted;
+}
+
+int FacilityOccupancy::FacilityIndexOf(const long long vehicle_id) const {
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= facility_by_id_.size() || facility_by_id_[id_index] == kNotCounted) {
+    return FacilityMap::kNoFacility;
+  }
+  return facility_by_id_[id_index];
+}
+
+void FacilityOccupancy::Account(const size_t slot, const int facility_index, const int sign) {
+  if (facility_index == FacilityMap::kNoFacility) {
+    return;
+  }
+  Counts& counts = counts_by_facility_[static_cast<size_t>(facility_index)];
+  const VehicleType type = vehicles_.Type(slot);
+  const bool is_air = type == VehicleType::FIGHTER || type == VehicleType::HELICOPTER;
+  if (vehicles_.PlayerId(slot) == my_id_) {
+    (is_air ? counts.my_air : counts.my_ground) += sign;
+  }
+  else {
+    (is_air ? counts.enemy_air : counts.enemy_ground) += sign;
+  }
+}
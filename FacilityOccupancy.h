@@ -0,0 +1,54 @@
+#pragma once
+#ifndef _FACILITY_OCCUPANCY_H_
+#define _FACILITY_OCCUPANCY_H_
+
+#include "Strategy.h"
+#include "FacilityMap.h"
+#include "VehicleStore.h"
+#include <memory>
+#include <vector>
+
+// Counts vehicles standing inside each facility, separately for mine and enemy's, ground and air ones.
+// The counts are patched on every addition, move and removal of a vehicle,
+// so that they are read in O(1) and reflect the updates of the current tick.
+class FacilityOccupancy {
+ public:
+  struct Counts {
+    int my_ground = 0;
+    int my_air = 0;
+    int enemy_ground = 0;
+    int enemy_air = 0;
+
+    int Mine() const { return my_ground + my_air; }
+    int Enemy() const { return enemy_ground + enemy_air; }
+  };
+
+  FacilityOccupancy(const VehicleStore& vehicles, std::shared_ptr<const FacilityMap> facility_map,
+                    const long long my_id);
+
+  // Must be called after the corresponding change in VehicleStore (Remove - before it)
+  void Insert(const long long vehicle_id);
+  void Move(const long long vehicle_id);
+  void Remove(const long long vehicle_id);
+
+  // Index of the facility the vehicle stands in (FacilityMap::kNoFacility if it's outside all facilities)
+  int FacilityIndexOf(const long long vehicle_id) const;
+
+  const Counts& CountsAt(const size_t facility_index) const { return counts_by_facility_[facility_index]; }
+
+ private:
+  // Adds (sign = 1) or subtracts (sign = -1) the vehicle to/from the counts of the facility
+  void Account(const size_t slot, const int facility_index, const int sign);
+
+  const VehicleStore& vehicles_;
+  const std::shared_ptr<const FacilityMap> facility_map_;
+  const long long my_id_;
+
+  std::vector<Counts> counts_by_facility_;
+  // The facility each vehicle has been counted in, or kNotCounted
+  std::vector<int> facility_by_id_;
+
+  static const int kNotCounted = -2;
+};
+
+#endif
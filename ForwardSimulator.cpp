@@ -0,0 +1,371 @@
+#include "ForwardSimulator.h"
+
+#include <cmath>
+#include <limits>
+
+using namespace model;
+
+namespace {
+
+const float kNoSpeedLimit = std::numeric_limits<float>::max();
+
+bool IsInside(const float x, const float y, const Move& move) {
+  return x >= move.getLeft() && x <= move.getRight() && y >= move.getTop() && y <= move.getBottom();
+}
+
+// next = from + (to - from) * ratio; a branch-free loop over separate arrays,
+// with few enough possible overlaps that the compiler vectorizes it
+void StepTowards(const float* from, const float* to, const float* ratios, float* next, const size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    next[i] = from[i] + (to[i] - from[i]) * ratios[i];
+  }
+}
+
+}  // namespace
+
+ForwardSimulator::ForwardSimulator(const std::shared_ptr<const SimulationRules>& rules) : rules_(rules) {
+  // A vehicle which has no enemies around doesn't look for them again until they may come into the range,
+  // so they are looked for farther than the range
+  for (CellGrid& grid : grid_by_player_) {
+    grid.Reset(rules_->WorldSideLength(), AttackSearchRadius());
+  }
+  repair_grid_.Reset(rules_->WorldSideLength(), rules_->RepairRange());
+  // A vehicle looks for those it may collide with within two radii plus its step, so with cells twice as large
+  // at most four of them are visited
+  collision_grid_.Reset(rules_->WorldSideLength(), 2 * (2 * rules_->VehicleRadius() + rules_->MaxSpeed()));
+}
+
+void ForwardSimulator::Load(const VehicleStore& vehicles, const long long my_id) {
+  const size_t size = vehicles.Size();
+  ids_.resize(size);
+  types_.resize(size);
+  is_mine_.resize(size);
+  is_aerial_.resize(size);
+  is_selected_.resize(size);
+  collision_layers_.resize(size);
+  xs_.resize(size);
+  ys_.resize(size);
+  durabilities_.resize(size);
+  max_durabilities_.resize(size);
+  base_speeds_.resize(size);
+  speed_factors_.resize(size);
+  speed_cells_.resize(size);
+  attack_cooldowns_.assign(size, 0);
+  destination_xs_.resize(size);
+  destination_ys_.resize(size);
+  speed_limits_.assign(size, kNoSpeedLimit);
+  speeds_.resize(size);
+  step_ratios_.resize(size);
+  next_xs_.resize(size);
+  next_ys_.resize(size);
+  durability_changes_.resize(size);
+  is_repaired_.resize(size);
+  for (size_t slot = 0; slot < size; slot++) {
+    ids_[slot] = vehicles.Id(slot);
+    types_[slot] = static_cast<std::uint8_t>(vehicles.Type(slot));
+    is_mine_[slot] = vehicles.PlayerId(slot) == my_id;
+    is_aerial_[slot] = rules_->ForType(vehicles.Type(slot)).is_aerial;
+    is_selected_[slot] = is_mine_[slot] && vehicles.IsSelected(slot);
+    collision_layers_[slot] = is_aerial_[slot] ? 1 + is_mine_[slot] : 0;
+    xs_[slot] = static_cast<float>(vehicles.X(slot));
+    ys_[slot] = static_cast<float>(vehicles.Y(slot));
+    durabilities_[slot] = static_cast<float>(vehicles.Durability(slot));
+    max_durabilities_[slot] = static_cast<float>(vehicles.MaxDurability(slot));
+    base_speeds_[slot] = rules_->ForType(vehicles.Type(slot)).speed;
+    speed_cells_[slot] = rules_->CellOf(xs_[slot], ys_[slot]);
+    speed_factors_[slot] = rules_->SpeedFactor(is_aerial_[slot] != 0, speed_cells_[slot]);
+  }
+  destination_xs_ = xs_;
+  destination_ys_ = ys_;
+  simulated_ticks_ = 0;
+  is_player_grid_stale_[0] = is_player_grid_stale_[1] = true;
+  is_collision_grid_stale_ = true;
+  is_nuclear_strike_pending_ = false;
+}
+
+void ForwardSimulator::Apply(const Action& action) {
+  Move move;
+  action.Execute(move);
+  const size_t size = Size();
+  switch (move.getAction()) {
+    case ActionType::CLEAR_AND_SELECT:
+    case ActionType::ADD_TO_SELECTION: {
+      const bool is_cleared = move.getAction() == ActionType::CLEAR_AND_SELECT;
+      const bool is_any_type = move.getVehicleType() == VehicleType::_UNKNOWN_;
+      const std::uint8_t type = static_cast<std::uint8_t>(move.getVehicleType());
+      for (size_t i = 0; i < size; i++) {
+        const bool is_matching = is_mine_[i] && IsAlive(i) && IsInside(xs_[i], ys_[i], move) &&
+                                 (is_any_type || types_[i] == type);
+        is_selected_[i] = is_matching || (!is_cleared && is_selected_[i]);
+      }
+      break;
+    }
+    case ActionType::MOVE:
+    case ActionType::ROTATE:
+    case ActionType::SCALE: {
+      const float cx = static_cast<float>(move.getX());
+      const float cy = static_cast<float>(move.getY());
+      const float cos_angle = static_cast<float>(std::cos(move.getAngle()));
+      const float sin_angle = static_cast<float>(std::sin(move.getAngle()));
+      const float factor = static_cast<float>(move.getFactor());
+      const float speed_limit = move.getMaxSpeed() > 0 ? static_cast<float>(move.getMaxSpeed()) : kNoSpeedLimit;
+      for (size_t i = 0; i < size; i++) {
+        if (!is_selected_[i]) {
+          continue;
+        }
+        const float dx = xs_[i] - cx;
+        const float dy = ys_[i] - cy;
+        if (move.getAction() == ActionType::MOVE) {
+          // (x, y) is the shift here
+          destination_xs_[i] = xs_[i] + cx;
+          destination_ys_[i] = ys_[i] + cy;
+        }
+        else if (move.getAction() == ActionType::ROTATE) {
+          // The vehicle goes to its final position along the chord rather than along the arc
+          destination_xs_[i] = cx + dx * cos_angle - dy * sin_angle;
+          destination_ys_[i] = cy + dx * sin_angle + dy * cos_angle;
+        }
+        else {
+          destination_xs_[i] = cx + dx * factor;
+          destination_ys_[i] = cy + dy * factor;
+        }
+        speed_limits_[i] = speed_limit;
+      }
+      break;
+    }
+    case ActionType::TACTICAL_NUCLEAR_STRIKE: {
+      const size_t launcher = FindMine(move.getVehicleId());
+      if (launcher != size && !is_nuclear_strike_pending_) {
+        is_nuclear_strike_pending_ = true;
+        nuclear_strike_ticks_left_ = rules_->NuclearStrikeDelay();
+        nuclear_launcher_ = launcher;
+        nuclear_strike_x_ = static_cast<float>(move.getX());
+        nuclear_strike_y_ = static_cast<float>(move.getY());
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void ForwardSimulator::Simulate(const int ticks) {
+  for (int tick = 0; tick < ticks; tick++) {
+    MoveVehicles();
+    Fight();
+    if (is_nuclear_strike_pending_ && --nuclear_strike_ticks_left_ <= 0) {
+      DetonateNuclearStrike();
+    }
+    simulated_ticks_++;
+  }
+}
+
+float ForwardSimulator::DurabilitySum(const bool mine) const {
+  float sum = 0;
+  for (size_t i = 0; i < Size(); i++) {
+    sum += (is_mine_[i] != 0) == mine ? std::max(0.0f, durabilities_[i]) : 0.0f;
+  }
+  return sum;
+}
+
+int ForwardSimulator::AliveCount(const bool mine) const {
+  int count = 0;
+  for (size_t i = 0; i < Size(); i++) {
+    count += (is_mine_[i] != 0) == mine && durabilities_[i] > 0;
+  }
+  return count;
+}
+
+void ForwardSimulator::MoveVehicles() {
+  // Length of the step and its part of the way to the destination
+  const size_t size = Size();
+  for (size_t i = 0; i < size; i++) {
+    const float speed = base_speeds_[i] * speed_factors_[i];
+    const float dx = destination_xs_[i] - xs_[i];
+    const float dy = destination_ys_[i] - ys_[i];
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    speeds_[i] = durabilities_[i] > 0 ? std::min(std::min(speed, speed_limits_[i]), distance) : 0.0f;
+    step_ratios_[i] = speeds_[i] / std::max(distance, 1e-6f);
+  }
+
+  // Straight step towards the destination, one coordinate at a time, so that it's vectorized
+  StepTowards(xs_.data(), destination_xs_.data(), step_ratios_.data(), next_xs_.data(), size);
+  StepTowards(ys_.data(), destination_ys_.data(), step_ratios_.data(), next_ys_.data(), size);
+
+  // A step is cancelled if it ends too close to a neighbour (at its position at the start of the tick)
+  // and brings the vehicle even closer to it
+  if (is_collision_grid_stale_) {
+    collision_grid_.Build(xs_, ys_, [this](const size_t i) { return durabilities_[i] > 0; });
+    is_collision_grid_stale_ = false;
+  }
+  const float min_squared_distance = 4 * rules_->VehicleRadius() * rules_->VehicleRadius();
+  for (size_t i = 0; i < size; i++) {
+    if (next_xs_[i] == xs_[i] && next_ys_[i] == ys_[i]) {
+      continue;
+    }
+    // Within a tick a vehicle can only collide with those which were closer than two radii plus its step
+    const float collision_radius = 2 * rules_->VehicleRadius() + speeds_[i];
+    const float x = xs_[i];
+    const float y = ys_[i];
+    const float next_x = next_xs_[i];
+    const float next_y = next_ys_[i];
+    const std::uint8_t layer = collision_layers_[i];
+    bool is_blocked = false;
+    collision_grid_.ForEachWithin(x, y, collision_radius, [&](const size_t j) {
+      if (is_blocked || collision_layers_[j] != layer || j == i) {
+        return;
+      }
+      const float next_dx = next_x - xs_[j];
+      const float next_dy = next_y - ys_[j];
+      const float next_squared_distance = next_dx * next_dx + next_dy * next_dy;
+      if (next_squared_distance < min_squared_distance) {
+        const float dx = x - xs_[j];
+        const float dy = y - ys_[j];
+        is_blocked = next_squared_distance < dx * dx + dy * dy;
+      }
+    });
+    if (is_blocked) {
+      next_xs_[i] = xs_[i];
+      next_ys_[i] = ys_[i];
+      continue;
+    }
+    InvalidateGrids(i);
+    const std::uint32_t cell = rules_->CellOf(next_x, next_y);
+    if (cell != speed_cells_[i]) {
+      speed_cells_[i] = cell;
+      speed_factors_[i] = rules_->SpeedFactor(is_aerial_[i] != 0, cell);
+    }
+  }
+  xs_.swap(next_xs_);
+  ys_.swap(next_ys_);
+}
+
+void ForwardSimulator::Fight() {
+  const size_t size = Size();
+  std::fill(durability_changes_.begin(), durability_changes_.end(), 0.0f);
+  for (int mine = 0; mine < 2; mine++) {
+    if (is_player_grid_stale_[mine]) {
+      grid_by_player_[mine].Build(xs_, ys_, [this, mine](const size_t i) {
+        return durabilities_[i] > 0 && is_mine_[i] == mine;
+      });
+      is_player_grid_stale_[mine] = false;
+    }
+  }
+
+  for (size_t i = 0; i < size; i++) {
+    if (durabilities_[i] <= 0 || attack_cooldowns_[i] > 0) {
+      attack_cooldowns_[i] = std::max(0, attack_cooldowns_[i] - 1);
+      continue;
+    }
+    const SimulationRules::TypeRules& rules = rules_->ForType(Type(i));
+    if (rules.ground_damage <= 0 && rules.aerial_damage <= 0) {
+      continue;
+    }
+    // The closest enemy this vehicle can damage, and the closest one within the range of attack
+    size_t target = size;
+    float target_squared_distance = std::numeric_limits<float>::max();
+    float closest_squared_distance = AttackSearchRadius() * AttackSearchRadius();
+    grid_by_player_[!is_mine_[i]].ForEachWithin(xs_[i], ys_[i], AttackSearchRadius(), [&](const size_t j) {
+      if (rules_->Damage(Type(i), Type(j)) <= 0) {
+        return;
+      }
+      const float range = is_aerial_[j] ? rules.aerial_attack_range : rules.ground_attack_range;
+      const float dx = xs_[j] - xs_[i];
+      const float dy = ys_[j] - ys_[i];
+      const float squared_distance = dx * dx + dy * dy;
+      closest_squared_distance = std::min(closest_squared_distance, squared_distance);
+      if (squared_distance <= range * range && squared_distance < target_squared_distance) {
+        target = j;
+        target_squared_distance = squared_distance;
+      }
+    });
+    if (target != size) {
+      durability_changes_[target] -= rules_->Damage(Type(i), Type(target));
+      attack_cooldowns_[i] = rules.attack_cooldown_ticks;
+    }
+    else {
+      // No enemy can come into the range sooner, even if both vehicles move towards each other at full speed
+      const float range = std::max(rules.ground_attack_range, rules.aerial_attack_range);
+      const float gap = std::sqrt(closest_squared_distance) - range;
+      attack_cooldowns_[i] = std::max(0, static_cast<int>(gap / (2 * rules_->MaxSpeed())));
+    }
+  }
+  if (simulated_ticks_ % kRepairIntervalTicks == 0) {
+    Repair();
+  }
+
+  // Damage is applied after all attacks, as all of them happen at the same time
+  for (size_t i = 0; i < size; i++) {
+    const bool was_alive = durabilities_[i] > 0;
+    durabilities_[i] = std::min(max_durabilities_[i], durabilities_[i] + durability_changes_[i]);
+    if (was_alive && durabilities_[i] <= 0) {
+      InvalidateGrids(i);
+    }
+  }
+}
+
+void ForwardSimulator::Repair() {
+  const size_t size = Size();
+  const float squared_repair_range = rules_->RepairRange() * rules_->RepairRange();
+  std::fill(is_repaired_.begin(), is_repaired_.end(), 0);
+  repair_grid_.Build(xs_, ys_, [this](const size_t i) {
+    return durabilities_[i] > 0 && durabilities_[i] < max_durabilities_[i];
+  });
+  for (size_t i = 0; i < size; i++) {
+    if (durabilities_[i] <= 0 || Type(i) != VehicleType::ARRV) {
+      continue;
+    }
+    repair_grid_.ForEachWithin(xs_[i], ys_[i], rules_->RepairRange(), [&](const size_t j) {
+      if (is_repaired_[j] || j == i || is_mine_[i] != is_mine_[j]) {
+        return;
+      }
+      const float dx = xs_[j] - xs_[i];
+      const float dy = ys_[j] - ys_[i];
+      if (dx * dx + dy * dy <= squared_repair_range) {
+        // Several ARRVs around don't speed the repair up
+        is_repaired_[j] = 1;
+        durability_changes_[j] += rules_->RepairSpeed() * kRepairIntervalTicks;
+      }
+    });
+  }
+}
+
+void ForwardSimulator::DetonateNuclearStrike() {
+  is_nuclear_strike_pending_ = false;
+  if (durabilities_[nuclear_launcher_] <= 0) {
+    return;
+  }
+  const float radius = rules_->NuclearStrikeRadius();
+  const float max_damage = rules_->MaxNuclearStrikeDamage();
+  for (size_t i = 0; i < Size(); i++) {
+    const float dx = xs_[i] - nuclear_strike_x_;
+    const float dy = ys_[i] - nuclear_strike_y_;
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    const bool was_alive = durabilities_[i] > 0;
+    durabilities_[i] -= max_damage * std::max(0.0f, 1 - distance / radius);
+    if (was_alive && durabilities_[i] <= 0) {
+      InvalidateGrids(i);
+    }
+  }
+}
+
+float ForwardSimulator::AttackSearchRadius() const {
+  return rules_->MaxInteractionRange() + 2 * rules_->MaxSpeed() * kAttackSearchTicks;
+}
+
+size_t ForwardSimulator::FindMine(const long long vehicle_id) const {
+  for (size_t i = 0; i < Size(); i++) {
+    if (ids_[i] == vehicle_id && is_mine_[i] && IsAlive(i)) {
+      return i;
+    }
+  }
+  return Size();
+}
+
+const std::uint32_t ForwardSimulator::CellGrid::kNotIncluded = std::numeric_limits<std::uint32_t>::max();
+
+void ForwardSimulator::CellGrid::Reset(const float world_side_length, const float cell_side_length) {
+  cell_side_length_ = std::max(1.0f, cell_side_length);
+  cells_linear_count_ = std::max(1, static_cast<int>(std::ceil(world_side_length / cell_side_length_)));
+}
+
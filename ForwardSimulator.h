@@ -0,0 +1,239 @@
+#pragma once
+#ifndef _FORWARD_SIMULATOR_H_
+#define _FORWARD_SIMULATOR_H_
+
+#include "Strategy.h"
+#include "Action.h"
+#include "SimulationRules.h"
+#include "VehicleStore.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Rolls the state of all known vehicles forward, so that orders can be compared before they are queued.
+// It is an approximation of the game rules:
+// - every vehicle moves straight to its destination (rotations included)
+//   at the speed of its type multiplied by the terrain or weather factor under it;
+// - a move that brings a vehicle closer than two radii to another one of the same layer is cancelled
+//   (ground vehicles collide with all ground ones, aerial ones - with aerial ones of the same player);
+// - a vehicle which is ready to fire hits the closest enemy in range that it can damage
+//   (rather than a random one);
+// - ARRVs repair vehicles of their player around them (repairs are applied every few ticks),
+//   and nuclear damage decreases linearly from the epicenter.
+// Actions are applied at once (as if all of them were made on the current tick).
+//
+// The state is kept as packed arrays, the movement kernel is branch-free, so that the compiler vectorizes it,
+// and neighbours are looked up in grids which are rebuilt only after the vehicles in them have moved or died.
+// The simulator is copyable: a loaded state can be copied to try several orders from the same start.
+class ForwardSimulator {
+ public:
+  explicit ForwardSimulator(const std::shared_ptr<const SimulationRules>& rules);
+
+  // Takes the current state of all vehicles (selection of my vehicles included), cancelling all orders
+  void Load(const VehicleStore& vehicles, const long long my_id);
+
+  // Applies my action (selection, movement or nuclear strike; other ones are ignored)
+  void Apply(const Action& action);
+
+  void Simulate(const int ticks);
+
+  size_t Size() const { return ids_.size(); }
+  bool IsAlive(const size_t i) const { return durabilities_[i] > 0; }
+  bool IsMine(const size_t i) const { return is_mine_[i] != 0; }
+  long long Id(const size_t i) const { return ids_[i]; }
+  model::VehicleType Type(const size_t i) const { return static_cast<model::VehicleType>(types_[i]); }
+  float X(const size_t i) const { return xs_[i]; }
+  float Y(const size_t i) const { return ys_[i]; }
+  float Durability(const size_t i) const { return std::max(0.0f, durabilities_[i]); }
+
+  // Ticks simulated since Load()
+  int SimulatedTicks() const { return simulated_ticks_; }
+
+  // Total durability and number of alive vehicles of a player
+  float DurabilitySum(const bool mine) const;
+  int AliveCount(const bool mine) const;
+
+ private:
+  // Number of ticks for which a vehicle without enemies around may skip looking for them
+  static const int kAttackSearchTicks = 8;
+  // Repairs are accumulated for this number of ticks and applied at once
+  static const int kRepairIntervalTicks = 10;
+
+  void MoveVehicles();
+  void Fight();
+  void Repair();
+  void DetonateNuclearStrike();
+
+  // Marks the grids containing the vehicle as stale after it has moved or died
+  void InvalidateGrids(const size_t i) {
+    is_player_grid_stale_[is_mine_[i]] = true;
+    is_collision_grid_stale_ = true;
+  }
+
+  // Distance at which a vehicle looks for enemies
+  float AttackSearchRadius() const;
+
+  // Slot of my alive vehicle, or Size() if there is no such one
+  size_t FindMine(const long long vehicle_id) const;
+
+  // Vehicles sorted by square cells (a counting sort without allocations). If there are many more cells
+  // than vehicles, cells are hashed into buckets, whose number depends on the number of vehicles,
+  // so that even a grid of small cells is rebuilt in time linear in the number of vehicles
+  class CellGrid {
+   public:
+    void Reset(const float world_side_length, const float cell_side_length);
+
+    // Sorts vehicles i for which `is_included(i)` holds
+    template <typename Predicate>
+    void Build(const std::vector<float>& xs, const std::vector<float>& ys, Predicate is_included);
+
+    // Calls `visitor(j)` once for every vehicle from the cells overlapping the square
+    // with the center at the point and the half-side `radius`, which must not exceed the side of a cell
+    // (vehicles from other cells sharing a bucket with them may be visited too)
+    template <typename Visitor>
+    void ForEachWithin(const float x, const float y, const float radius, Visitor visitor) const;
+
+   private:
+    static const std::uint32_t kNotIncluded;
+    static const std::uint32_t kBucketsPerVehicle = 4;
+
+    int CellCoordinate(const float coordinate) const {
+      return std::min(cells_linear_count_ - 1, std::max(0, static_cast<int>(coordinate / cell_side_length_)));
+    }
+    std::uint32_t BucketOf(const int x_cell, const int y_cell) const {
+      return is_hashed_ ?
+             (static_cast<std::uint32_t>(x_cell) * 73856093u ^ static_cast<std::uint32_t>(y_cell) * 19349663u) &
+             bucket_mask_ :
+             static_cast<std::uint32_t>(x_cell * cells_linear_count_ + y_cell);
+    }
+
+    int cells_linear_count_ = 1;
+    float cell_side_length_ = 1;
+    bool is_hashed_ = false;
+    std::uint32_t bucket_mask_ = 0;
+    // Vehicles of bucket b are sorted_[bucket_starts_[b] .. bucket_starts_[b + 1])
+    std::vector<std::uint32_t> bucket_starts_;
+    std::vector<std::uint32_t> bucket_by_vehicle_;
+    std::vector<std::uint32_t> sorted_;
+  };
+
+  std::shared_ptr<const SimulationRules> rules_;
+  int simulated_ticks_ = 0;
+
+  // Per-vehicle state
+  std::vector<long long> ids_;
+  std::vector<std::uint8_t> types_;
+  std::vector<std::uint8_t> is_mine_;
+  std::vector<std::uint8_t> is_aerial_;
+  std::vector<std::uint8_t> is_selected_;
+  // Vehicles may collide only if their layers are equal: all ground ones share a layer,
+  // and aerial ones of each player have their own
+  std::vector<std::uint8_t> collision_layers_;
+  std::vector<float> xs_;
+  std::vector<float> ys_;
+  std::vector<float> durabilities_;
+  std::vector<float> max_durabilities_;
+  // Speed of the vehicle's type, and the terrain or weather factor of the cell it's in
+  // (which is looked up again only when the vehicle moves to another cell)
+  std::vector<float> base_speeds_;
+  std::vector<float> speed_factors_;
+  std::vector<std::uint32_t> speed_cells_;
+  // Ticks before the vehicle may attack: the cooldown after an attack,
+  // or the time which the closest enemy needs to come into the range of attack
+  std::vector<int> attack_cooldowns_;
+  // Current order: destination and speed limit
+  std::vector<float> destination_xs_;
+  std::vector<float> destination_ys_;
+  std::vector<float> speed_limits_;
+
+  // Scratch arrays of a tick
+  std::vector<float> speeds_;
+  std::vector<float> step_ratios_;
+  std::vector<float> next_xs_;
+  std::vector<float> next_ys_;
+  std::vector<float> durability_changes_;
+  std::vector<std::uint8_t> is_repaired_;
+
+  // Alive vehicles of each player (indexed by is_mine_), for looking for targets
+  CellGrid grid_by_player_[2];
+  // Alive damaged vehicles, for repairs
+  CellGrid repair_grid_;
+  // Neighbours a vehicle may collide with during a tick
+  CellGrid collision_grid_;
+  bool is_player_grid_stale_[2] = { true, true };
+  bool is_collision_grid_stale_ = true;
+
+  // Nuclear strike that has been ordered and hasn't happened yet
+  bool is_nuclear_strike_pending_ = false;
+  int nuclear_strike_ticks_left_ = 0;
+  size_t nuclear_launcher_ = 0;
+  float nuclear_strike_x_ = 0;
+  float nuclear_strike_y_ = 0;
+};
+
+template <typename Predicate>
+void ForwardSimulator::CellGrid::Build(const std::vector<float>& xs, const std::vector<float>& ys,
+                                       Predicate is_included) {
+  bucket_by_vehicle_.resize(xs.size());
+  std::uint32_t included_count = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    const bool is_vehicle_included = is_included(i);
+    bucket_by_vehicle_[i] = is_vehicle_included ? 0 : kNotIncluded;
+    included_count += is_vehicle_included;
+  }
+  // Several buckets per vehicle, so that few occupied cells share a bucket
+  const std::uint32_t cells_count = static_cast<std::uint32_t>(cells_linear_count_ * cells_linear_count_);
+  std::uint32_t buckets_count = 16;
+  while (buckets_count < kBucketsPerVehicle * included_count) {
+    buckets_count *= 2;
+  }
+  is_hashed_ = buckets_count < cells_count;
+  buckets_count = is_hashed_ ? buckets_count : cells_count;
+  bucket_mask_ = buckets_count - 1;
+  bucket_starts_.assign(buckets_count + 1, 0);
+  for (size_t i = 0; i < xs.size(); i++) {
+    if (bucket_by_vehicle_[i] != kNotIncluded) {
+      bucket_by_vehicle_[i] = BucketOf(CellCoordinate(xs[i]), CellCoordinate(ys[i]));
+      bucket_starts_[bucket_by_vehicle_[i] + 1]++;
+    }
+  }
+  for (std::uint32_t bucket = 1; bucket <= buckets_count; bucket++) {
+    bucket_starts_[bucket] += bucket_starts_[bucket - 1];
+  }
+  // Filling moves each start to the start of the next bucket, so they are shifted back afterwards
+  sorted_.resize(included_count);
+  for (size_t i = 0; i < xs.size(); i++) {
+    if (bucket_by_vehicle_[i] != kNotIncluded) {
+      sorted_[bucket_starts_[bucket_by_vehicle_[i]]++] = static_cast<std::uint32_t>(i);
+    }
+  }
+  for (std::uint32_t bucket = buckets_count; bucket > 0; bucket--) {
+    bucket_starts_[bucket] = bucket_starts_[bucket - 1];
+  }
+  bucket_starts_[0] = 0;
+}
+
+template <typename Visitor>
+void ForwardSimulator::CellGrid::ForEachWithin(const float x, const float y, const float radius,
+                                               Visitor visitor) const {
+  const int max_x_cell = CellCoordinate(x + radius);
+  const int max_y_cell = CellCoordinate(y + radius);
+  std::uint32_t visited_buckets[9];
+  size_t visited_buckets_count = 0;
+  for (int cx = CellCoordinate(x - radius); cx <= max_x_cell; cx++) {
+    for (int cy = CellCoordinate(y - radius); cy <= max_y_cell; cy++) {
+      const std::uint32_t bucket = BucketOf(cx, cy);
+      if (is_hashed_ && std::find(visited_buckets, visited_buckets + visited_buckets_count, bucket) !=
+                        visited_buckets + visited_buckets_count) {
+        continue;
+      }
+      visited_buckets[visited_buckets_count++] = bucket;
+      for (std::uint32_t k = bucket_starts_[bucket]; k < bucket_starts_[bucket + 1]; k++) {
+        visitor(static_cast<size_t>(sorted_[k]));
+      }
+    }
+  }
+}
+
+#endif
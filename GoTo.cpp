@@ -8,6 +8,10 @@ void GoTo::Execute(model::Move& move) const {
   move.setY(shift_.y);
 }
 
-std::string GoTo::Name() const {
+const char* GoTo::Name() const {
   return "GoTo";
 }
+
+bool GoTo::operator == (const GoTo& other) const {
+  return shift_ == other.shift_;
+}
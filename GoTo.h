@@ -2,15 +2,15 @@
 #ifndef _GO_TO_H_
 #define _GO_TO_H_
 
-#include "Action.h"
 #include "Vect.h"
 
 // Orders current selection to change its position by vector `shift`
-class GoTo : public Action {
+class GoTo {
  public:
   GoTo(const Vect& shift);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  bool operator == (const GoTo& other) const;
 
  private:
   Vect shift_;
@@ -10,6 +10,10 @@ void GoToWithSpeedLimit::Execute(model::Move& move) const {
   move.setMaxSpeed(speed_limit_);
 }
 
-std::string GoToWithSpeedLimit::Name() const {
+const char* GoToWithSpeedLimit::Name() const {
   return "GoToWithSpeedLimit";
 }
+
+bool GoToWithSpeedLimit::operator == (const GoToWithSpeedLimit& other) const {
+  return shift_ == other.shift_ && speed_limit_ == other.speed_limit_;
+}
@@ -0,0 +1,26 @@
+#include "IdleWorkScheduler.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+
+void IdleWorkScheduler::Schedule(IdleJob* job) {
+  if (std::find(jobs_.begin(), jobs_.end(), job) == jobs_.end()) {
+    jobs_.push_back(job);
+  }
+}
+
+void IdleWorkScheduler::RunSlices(const int current_tick, const size_t max_slices) {
+  PROFILE_SCOPE(IDLE_WORK);
+  for (size_t slices = 0; slices < max_slices && !jobs_.empty(); slices++) {
+    if (next_job_ >= jobs_.size()) {
+      next_job_ = 0;
+    }
+    if (jobs_[next_job_]->RunSlice(current_tick)) {
+      jobs_.erase(jobs_.begin() + next_job_);
+    }
+    else {
+      next_job_++;
+    }
+  }
+}
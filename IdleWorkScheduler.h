@@ -0,0 +1,39 @@
+#pragma once
+#ifndef _IDLE_WORK_SCHEDULER_H_
+#define _IDLE_WORK_SCHEDULER_H_
+
+#include <cstddef>
+#include <vector>
+
+// A computation split into bounded slices, so that it can be spread over several ticks
+class IdleJob {
+ public:
+  virtual ~IdleJob() = default;
+
+  // Does the next bounded piece of work on the tick; returns true when the whole job is done
+  virtual bool RunSlice(const int current_tick) = 0;
+};
+
+// Runs slices of scheduled jobs on the ticks when no decisions are made,
+// so that heavy analysis is ready by the next planning tick instead of landing on it at once.
+// Jobs are owned by their users, which restart them and read their results;
+// a job is forgotten here as soon as it's done.
+class IdleWorkScheduler {
+ public:
+  // Slices run on a tick between planning ticks
+  static const size_t kSlicesPerIdleTick = 4;
+
+  // Adds a job (or keeps it, if it's scheduled already) to the end of the round-robin
+  void Schedule(IdleJob* job);
+
+  // Runs up to `max_slices` slices, taking jobs in turn
+  void RunSlices(const int current_tick, const size_t max_slices = kSlicesPerIdleTick);
+
+  bool Empty() const { return jobs_.empty(); }
+
+ private:
+  std::vector<IdleJob*> jobs_;
+  size_t next_job_ = 0;
+};
+
+#endif
@@ -1,26 +1,92 @@
 #include "MotionlessnessChecker.h"
 
-MotionlessnessChecker::MotionlessnessChecker(const std::map<long long, model::Vehicle>& vehicle_by_id,
-                                             std::map<long long, int>& vehicle_coordinates_update_tick_by_id,
+#include <algorithm>
+#include <limits>
+
+MotionlessnessChecker::MotionlessnessChecker(const VehicleStore& vehicles, const long long my_id,
                                              const int number_of_vehicle_types)
     : kNumberOfVehicleTypes(number_of_vehicle_types),
-      vehicle_by_id_(vehicle_by_id),
-      vehicle_coordinates_update_tick_by_id_(vehicle_coordinates_update_tick_by_id) {}
-
-void MotionlessnessChecker::CheckMyVehiclesMotionlessness(const model::Player& me, const int current_tick) {
-  are_all_vehicles_of_type_motionless_ = std::vector<bool>(kNumberOfVehicleTypes, true);
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const model::Vehicle& vehicle = id_and_vehicle.second;    
-    if (vehicle.getPlayerId() == me.getId()) {
-      if (!IsVehicleMotionless(vehicle, current_tick)) {
-        are_all_vehicles_of_type_motionless_[static_cast<size_t>(vehicle.getType())] = false;
+      vehicles_(vehicles),
+      my_id_(my_id),
+      timing_wheel_(kWheelSize),
+      moving_count_by_type_(number_of_vehicle_types),
+      marked_as_moving_tick_by_type_(number_of_vehicle_types, std::numeric_limits<int>::min() / 2),
+      are_all_vehicles_of_type_motionless_(number_of_vehicle_types, true) {}
+
+void MotionlessnessChecker::RegisterMove(const long long vehicle_id, const int current_tick) {
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  if (slot == VehicleStore::kNoSlot || vehicles_.PlayerId(slot) != my_id_) {
+    return;
+  }
+  AdvanceWheel(current_tick);
+
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= is_moving_by_id_.size()) {
+    is_moving_by_id_.resize(id_index * 2 + 1);
+  }
+  if (!is_moving_by_id_[id_index]) {
+    is_moving_by_id_[id_index] = true;
+    moving_count_by_type_[static_cast<size_t>(vehicles_.Type(slot))]++;
+  }
+  const int expiration_tick = vehicles_.MoveTick(slot) + kMotionCooldown + 1;
+  timing_wheel_[expiration_tick % kWheelSize].push_back({ vehicle_id, vehicles_.MoveTick(slot) });
+}
+
+void MotionlessnessChecker::Forget(const long long vehicle_id) {
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (slot == VehicleStore::kNoSlot || id_index >= is_moving_by_id_.size() || !is_moving_by_id_[id_index]) {
+    return;
+  }
+  is_moving_by_id_[id_index] = false;
+  moving_count_by_type_[static_cast<size_t>(vehicles_.Type(slot))]--;
+}
+
+void MotionlessnessChecker::MarkTypesAsMoving(const std::vector<model::VehicleType>& types, const int current_tick) {
+  for (const model::VehicleType& type : types) {
+    marked_as_moving_tick_by_type_[static_cast<size_t>(type)] = current_tick;
+  }
+}
+
+void MotionlessnessChecker::AdvanceWheel(const int current_tick) {
+  // Moves stored for the skipped ticks are still in the wheel and will be expired later
+  // (every stored move is checked against the vehicle's latest move)
+  for (int tick = std::max(wheel_tick_ + 1, current_tick - kWheelSize + 1); tick <= current_tick; tick++) {
+    std::vector<RecentMove>& expiring_moves = timing_wheel_[tick % kWheelSize];
+    for (const RecentMove& move : expiring_moves) {
+      const size_t id_index = static_cast<size_t>(move.vehicle_id);
+      const size_t slot = vehicles_.SlotById(move.vehicle_id);
+      // Stale entries: the vehicle is destroyed or it has moved again (its later move is in the wheel too)
+      if (!is_moving_by_id_[id_index] || slot == VehicleStore::kNoSlot || vehicles_.MoveTick(slot) != move.move_tick) {
+        continue;
       }
+      is_moving_by_id_[id_index] = false;
+      moving_count_by_type_[static_cast<size_t>(vehicles_.Type(slot))]--;
     }
+    expiring_moves.clear();
+  }
+  wheel_tick_ = std::max(wheel_tick_, current_tick);
+}
+
+void MotionlessnessChecker::CheckMyVehiclesMotionlessness(const int current_tick) {
+  AdvanceWheel(current_tick);
+  for (int type = 0; type < kNumberOfVehicleTypes; type++) {
+    // A mark doesn't apply to a type which I don't have anymore
+    const bool is_marked_as_moving = marked_as_moving_tick_by_type_[type] >= current_tick - kMotionCooldown &&
+                                     vehicles_.CountByType(my_id_, static_cast<model::VehicleType>(type)) > 0;
+    are_all_vehicles_of_type_motionless_[type] = moving_count_by_type_[type] == 0 && !is_marked_as_moving;
   }
 }
 
-bool MotionlessnessChecker::IsVehicleMotionless(const model::Vehicle& vehicle, const int current_tick) const {
-  return vehicle_coordinates_update_tick_by_id_[vehicle.getId()] < current_tick - kMotionCooldown;
+bool MotionlessnessChecker::IsVehicleMotionless(const size_t slot, const int current_tick) const {
+  return EffectiveMoveTick(slot) < current_tick - kMotionCooldown;
+}
+
+int MotionlessnessChecker::EffectiveMoveTick(const size_t slot) const {
+  if (vehicles_.PlayerId(slot) != my_id_) {
+    return vehicles_.MoveTick(slot);
+  }
+  return std::max(vehicles_.MoveTick(slot), marked_as_moving_tick_by_type_[static_cast<size_t>(vehicles_.Type(slot))]);
 }
 
 bool MotionlessnessChecker::AreAllVehiclesOfTypeMotionless(const model::VehicleType& vehicle_type) const {
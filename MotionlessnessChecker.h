@@ -3,19 +3,35 @@
 #define _MOTIONLESSNESS_CHECKER_H_
 
 #include "Strategy.h"
-#include <map>
+#include "VehicleStore.h"
 #include <vector>
 
 // Checks if a specific vehicle (or all vehicles of specific type)
-// hasn't (haven't) moved for at least <kMotionCooldown> ticks
+// hasn't (haven't) moved for at least <kMotionCooldown> ticks.
+// Instead of scanning all vehicles, it counts my vehicles of each type that moved recently:
+// every move of my vehicle is reported here, and a timing wheel
+// expires the move <kMotionCooldown> ticks later unless the vehicle has moved again since then.
+// A whole type can also be marked as moving at once: my vehicle is then treated as moved
+// at the latest of its own move tick and the tick when its type was marked.
 class MotionlessnessChecker {
  public:
-  MotionlessnessChecker(const std::map<long long, model::Vehicle>& vehicle_by_id,
-                        std::map<long long, int>& vehicle_coordinates_update_tick_by_id,
-                        const int number_of_vehicle_types);
+  MotionlessnessChecker(const VehicleStore& vehicles, const long long my_id, const int number_of_vehicle_types);
 
-  void CheckMyVehiclesMotionlessness(const model::Player& me, const int current_tick);
-  bool IsVehicleMotionless(const model::Vehicle& vehicle, const int current_tick) const;
+  // Must be called whenever the move tick of a vehicle is set in VehicleStore (after that)
+  void RegisterMove(const long long vehicle_id, const int current_tick);
+
+  // Must be called before a vehicle is removed from VehicleStore
+  void Forget(const long long vehicle_id);
+
+  // Imitates that all my vehicles of the types have just moved, in O(1) per type.
+  // This is useful when a group received an order but it is queued,
+  // and therefore that group can still be treated as motionless
+  // which is undesirable for Regrouping Stage Transitions
+  void MarkTypesAsMoving(const std::vector<model::VehicleType>& types, const int current_tick);
+
+  // Takes a snapshot of motionlessness of each type (used by AreAllVehiclesOfType(s)Motionless)
+  void CheckMyVehiclesMotionlessness(const int current_tick);
+  bool IsVehicleMotionless(const size_t slot, const int current_tick) const;
 
   bool AreAllVehiclesOfTypeMotionless(const model::VehicleType& vehicle_type) const;
   bool AreAllVehiclesOfTypeMotionless(const size_t vehicle_type_index) const;
@@ -23,11 +39,32 @@ class MotionlessnessChecker {
   bool AreAllVehiclesOfTypesMotionless(const std::vector<model::VehicleType>& types) const;
 
  private:
+  // A move of a vehicle which stops counting when the wheel reaches the tick it's stored for
+  struct RecentMove {
+    long long vehicle_id;
+    int move_tick;
+  };
+
+  // The latest tick when the vehicle moved or was marked as moving along with its type
+  int EffectiveMoveTick(const size_t slot) const;
+
+  // Expires the moves stored for all ticks up to `current_tick` inclusive
+  void AdvanceWheel(const int current_tick);
+
   const int kMotionCooldown = 31;
+  // A move at tick T expires at tick T + kMotionCooldown + 1, so the wheel needs one more slot for the current tick
+  const int kWheelSize = kMotionCooldown + 2;
   const int kNumberOfVehicleTypes;
 
-  const std::map<long long, model::Vehicle>& vehicle_by_id_;
-  std::map<long long, int>& vehicle_coordinates_update_tick_by_id_;
+  const VehicleStore& vehicles_;
+  const long long my_id_;
+
+  std::vector<std::vector<RecentMove>> timing_wheel_;
+  int wheel_tick_ = -1; // the last tick whose moves have been expired
+
+  std::vector<int> moving_count_by_type_;
+  std::vector<int> marked_as_moving_tick_by_type_;
+  std::vector<bool> is_moving_by_id_;
 
   std::vector<bool> are_all_vehicles_of_type_motionless_;
 };
@@ -2,10 +2,43 @@
 
 #include "DecisionMakerForGameWithBuildings.h"
 #include "DecisionMakerForGameWithoutBuildings.h"
+#include "Profiler.h"
+
+#include <ctime>
+#ifdef MY_STRATEGY_RECORDING
+#include <cstdlib>
+#endif
 
 using namespace std;
 
+MyStrategy::~MyStrategy() {
+  // The game may end before its last tick (e.g. when one of the players loses all vehicles)
+  PrintSummary();
+}
+
 void MyStrategy::move(const Player& me, const World& world, const Game& game, Move& move) {
+#ifdef MY_STRATEGY_RECORDING
+  if (!tick_recorder_) {
+    const char* file_name = std::getenv("MY_STRATEGY_RECORDING_FILE");
+    tick_recorder_ = std::make_unique<TickRecorder>(file_name ? file_name : kDefaultRecordingFile);
+  }
+  tick_recorder_->RecordTick(me, world, game);
+#endif
+
+  {
+    PROFILE_SCOPE(MOVE);
+    const std::clock_t start = std::clock();
+    MakeMove(me, world, game, move);
+    decision_maker_->RegisterMoveCpuTime(world.getTickIndex(),
+                                         static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC);
+  }
+
+  if (world.getTickIndex() == world.getTickCount() - 1) {
+    PrintSummary();
+  }
+}
+
+void MyStrategy::MakeMove(const Player& me, const World& world, const Game& game, Move& move) {
   const int current_tick = world.getTickIndex();
   if (current_tick == 0) {
     if (!world.getFacilities().empty()) {
@@ -15,31 +48,45 @@ void MyStrategy::move(const Player& me, const World& world, const Game& game, Mo
       decision_maker_ = std::make_unique<DecisionMakerForGameWithoutBuildings>();
     }
     decision_maker_->InitializeHelperClasses(world, game);
+    action_point_scheduler_ = std::make_unique<ActionPointScheduler>(game);
+    selection_tracker_ = std::make_unique<SelectionTracker>(decision_maker_->Vehicles(), me.getId());
   }
 
   InitializeTick(world);
+  actions_.StartTick(current_tick);
 
-  bool performed_action = false;
-  if (CanMakeMove(current_tick, game)) {
-    decision_maker_->CheckMyVehiclesMotionlessness(me, current_tick);
+  if (IsPlanningTick(current_tick)) {
+    decision_maker_->CheckMyVehiclesMotionlessness(current_tick);
     decision_maker_->NuclearOperations(me, current_tick, actions_);
     decision_maker_->MakeDecisions(me, world, game, move, actions_);
+    actions_.Optimize();
+    decision_maker_->PlanIdleWork(me, idle_work_);
+  }
+  else {
+    idle_work_.RunSlices(current_tick);
+  }
 
-    // Executes an action with the highest priority.
-    // It is either the earliest one (by the time when it was planned) or
-    // the most urgent one (Nuclear Strike).
-    if (!actions_.empty()) {
-      actions_.front()->Execute(move);
-      actions_.pop_front();
-      performed_action = true;
-    }
+  // Executes an action with the highest priority.
+  // It is either the next one of the chain which has started already or
+  // the first one of the most important chain (see ActionScheduler).
+  // Actions are planned uniformly but made as soon as action points allow,
+  // so the points given by control centers and the ones left unused are spent too.
+  action_point_scheduler_->StartTick(me, world, actions_.Size(ActionPriority::URGENT) > 0 ||
+                                                decision_maker_->IsNuclearStrikePending());
+  if (!actions_.Empty() && action_point_scheduler_->CanAct(Action::IsUrgent(actions_.Front().GetKind()))) {
+    SkipRedundantSelection();
+    actions_.Front().Execute(move);
+    selection_tracker_->RegisterAction(actions_.Front());
+    actions_.PopFront();
+    action_point_scheduler_->RegisterAction();
   }
-  if (!performed_action) {
+  else {
     move.setAction(ActionType::NONE);
   }
 }
 
 void MyStrategy::InitializeTick(const World& world) const {
+  PROFILE_SCOPE(INITIALIZE_TICK);
   const int current_tick = world.getTickIndex();
 
   for (const Vehicle& vehicle : world.getNewVehicles()) {
@@ -51,8 +98,44 @@ void MyStrategy::InitializeTick(const World& world) const {
   }
 }
 
-// Checks if the move can be made
+void MyStrategy::SkipRedundantSelection() {
+  if (actions_.IsFrontChainStarted()) {
+    return;
+  }
+  const size_t chain_length = actions_.FrontChainLength();
+  unsigned int types = 0;
+  size_t selection_length = 0;
+  while (selection_length < chain_length && Action::IsSelection(actions_.Peek(selection_length).GetKind())) {
+    const Action& action = actions_.Peek(selection_length);
+    if (!Action::IsSelectionByVehicleType(action.GetKind()) ||
+        (selection_length == 0) != Action::StartsChain(action.GetKind())) {
+      return;
+    }
+    types |= SelectionTracker::TypeBit(action.SelectedVehicleType());
+    selection_length++;
+  }
+  // Orders must follow, otherwise there would be nothing to execute on this tick
+  if (selection_length == 0 || selection_length == chain_length || !selection_tracker_->AreExactlySelected(types)) {
+    return;
+  }
+  for (size_t i = 0; i < selection_length; i++) {
+    actions_.PopFront();
+  }
+}
+
+// Checks if new actions should be planned
 // assuming that we want to spend actions points as evenly as possible
-bool MyStrategy::CanMakeMove(const int current_tick, const Game& game) const {
+bool MyStrategy::IsPlanningTick(const int current_tick) const {
   return current_tick % decision_maker_->BaseUniformActionInterval() == 0;
 }
+
+void MyStrategy::PrintSummary() {
+#ifdef MY_STRATEGY_PROFILING
+  if (is_summary_printed_) {
+    return;
+  }
+  is_summary_printed_ = true;
+  Profiler::Instance().PrintSummary(stderr);
+  actions_.PrintWaitStatistics(stderr);
+#endif
+}
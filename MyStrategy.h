@@ -3,9 +3,14 @@
 #define _MY_STRATEGY_H_
 
 #include "Strategy.h"
-#include "Action.h"
+#include "ActionPointScheduler.h"
+#include "ActionScheduler.h"
 #include "DecisionMaker.h"
-#include <deque>
+#include "IdleWorkScheduler.h"
+#include "SelectionTracker.h"
+#ifdef MY_STRATEGY_RECORDING
+#include "TickRecorder.h"
+#endif
 #include <memory>
 
 using namespace model;
@@ -13,17 +18,41 @@ using namespace model;
 // Entry point of a strategy
 class MyStrategy : public Strategy {
  public:
+  // Prints the profiling summary if the game ended before its last tick (see PrintSummary())
+  ~MyStrategy() override;
+
   // Entry point of a strategy on each tick
   void move(const Player& me, const World& world, const Game& game, Move& move) override;
 
  private:
+  // Updates the state of the world and chooses the action for the current tick
+  void MakeMove(const Player& me, const World& world, const Game& game, Move& move);
+
   // Processes the information about world updates on each tick 
   void InitializeTick(const World& world) const;
 
-  bool CanMakeMove(const int current_tick, const Game& game) const;
+  bool IsPlanningTick(const int current_tick) const;
+
+  // Removes the selection the next chain starts with if exactly the same vehicles are selected already
+  void SkipRedundantSelection();
 
-  std::deque<std::unique_ptr<Action>> actions_; // contains planned actions
+  // Prints durations of the phases and waiting times of the chains once per game (with -DMY_STRATEGY_PROFILING)
+  void PrintSummary();
+
+  ActionScheduler actions_; // contains planned actions
+  std::unique_ptr<ActionPointScheduler> action_point_scheduler_;
+  std::unique_ptr<SelectionTracker> selection_tracker_;
+  IdleWorkScheduler idle_work_; // analysis spread over the ticks between planning ticks
   std::unique_ptr<DecisionMaker> decision_maker_;
+#ifdef MY_STRATEGY_PROFILING
+  bool is_summary_printed_ = false;
+#endif
+
+#ifdef MY_STRATEGY_RECORDING
+  // Records the game into a file (MY_STRATEGY_RECORDING_FILE environment variable or kDefaultRecordingFile)
+  const char* kDefaultRecordingFile = "my_strategy_ticks.bin";
+  std::unique_ptr<TickRecorder> tick_recorder_;
+#endif
 };
 
 #endif
@@ -3,92 +3,129 @@
 #include "Select.h"
 #include "GoTo.h"
 #include "NuclearStrike.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cmath>
 
 using model::Player;
-using model::Vehicle;
 
 using std::vector;
+using std::pair;
 
-NuclearAttackHandler::NuclearAttackHandler(const std::map<long long, Vehicle>& vehicle_by_id,
+NuclearAttackHandler::NuclearAttackHandler(const VehicleStore& vehicles,
+                                           const std::shared_ptr<SpatialGrid>& spatial_grid,
                                            const std::shared_ptr<VehicleValueEstimator>& vehicle_value_estimator,
                                            const std::shared_ptr<RuntimeConstants>& runtime_constants,
-                                           const std::shared_ptr<MotionlessnessChecker>& motionlessness_checker)
-    : vehicle_by_id_(vehicle_by_id),
+                                           const std::shared_ptr<MotionlessnessChecker>& motionlessness_checker,
+                                           const std::shared_ptr<WorkerPool>& worker_pool,
+                                           const std::shared_ptr<const CpuGovernor>& cpu_governor)
+    : vehicles_(vehicles),
+      spatial_grid_(spatial_grid),
+      worker_pool_(worker_pool),
+      cpu_governor_(cpu_governor),
+      packed_targets_by_worker_(worker_pool->WorkersCount()),
+      launcher_scoring_(*this),
       vehicle_value_estimator_(vehicle_value_estimator),
       runtime_constants_(runtime_constants),
-      motionlessness_checker_(motionlessness_checker) {
-  representatives_in_fragment_ = vector<vector<Vehicle>>(
+      motionlessness_checker_(motionlessness_checker),
+      kStrikeWindowLinearCount(std::min(runtime_constants->kFragmentsLinearCount, std::max(1u,
+        static_cast<unsigned int>(std::lround(
+          2 * runtime_constants->kTacticalNuclearStrikeRadius / runtime_constants->kFragmentSideLength))))) {
+  representatives_in_fragment_ = vector<vector<long long>>(
     runtime_constants->kFragmentsLinearCount,
-    vector<Vehicle>(runtime_constants->kFragmentsLinearCount));
+    vector<long long>(runtime_constants->kFragmentsLinearCount));
 }
 
 Vect NuclearAttackHandler::FindSquareWithLargestPotentialForNuclearStrike(const Player& me) {
-  vector<vector<Vect>> sum_enemy_position_by_fragment(runtime_constants_->kFragmentsLinearCount,
-    vector<Vect>(runtime_constants_->kFragmentsLinearCount));
-  vector<vector<int>> cnt_enemies_by_fragment(runtime_constants_->kFragmentsLinearCount,
-    vector<int>(runtime_constants_->kFragmentsLinearCount));
-  have_representatives_in_fragment_ = vector<vector<bool>>(runtime_constants_->kFragmentsLinearCount,
-    vector<bool>(runtime_constants_->kFragmentsLinearCount));
-  force_balance_by_fragment_ = vector<vector<int>>(runtime_constants_->kFragmentsLinearCount,
-    vector<int>(runtime_constants_->kFragmentsLinearCount));
+  PROFILE_SCOPE(FIND_NUCLEAR_STRIKE_SQUARE);
+  const unsigned int fragments_count = runtime_constants_->kFragmentsLinearCount;
+  have_representatives_in_fragment_ = vector<vector<bool>>(fragments_count, vector<bool>(fragments_count));
+  force_balance_.Reset(fragments_count);
+  enemies_cnt_.Reset(fragments_count);
+  enemies_sum_x_.Reset(fragments_count);
+  enemies_sum_y_.Reset(fragments_count);
 
   // consider all vehicles
-  for (const auto& id_and_vehicle : vehicle_by_id_) {
-    const Vehicle& vehicle = id_and_vehicle.second;
-
+  const long long my_id = me.getId();
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
     // map vehicle position onto one of the World fragments
-    int x_cell = int(vehicle.getX()) / runtime_constants_->kFragmentSideLength;
-    int y_cell = int(vehicle.getY()) / runtime_constants_->kFragmentSideLength;
-    Clamp(x_cell, 0, runtime_constants_->kFragmentsLinearCount - 1);
-    Clamp(y_cell, 0, runtime_constants_->kFragmentsLinearCount - 1);
-     
-    force_balance_by_fragment_[x_cell][y_cell] += vehicle_value_estimator_->CalculateVehicleValue(vehicle, me);
-        
-    if (vehicle.getPlayerId() != me.getId()) {
+    int x_cell = int(vehicles_.X(slot)) / runtime_constants_->kFragmentSideLength;
+    int y_cell = int(vehicles_.Y(slot)) / runtime_constants_->kFragmentSideLength;
+    Clamp(x_cell, 0, fragments_count - 1);
+    Clamp(y_cell, 0, fragments_count - 1);
+
+    const bool is_mine = vehicles_.PlayerId(slot) == my_id;
+    force_balance_.Add(x_cell, y_cell, vehicle_value_estimator_->CalculateVehicleValue(
+      vehicles_.Durability(slot), vehicles_.MaxDurability(slot), vehicles_.Type(slot), is_mine));
+
+    if (!is_mine) {
       // include opponent's vehicle into mass center calculation
-      sum_enemy_position_by_fragment[x_cell][y_cell] += Vect(vehicle);
-      cnt_enemies_by_fragment[x_cell][y_cell]++;
+      enemies_sum_x_.Add(x_cell, y_cell, vehicles_.X(slot));
+      enemies_sum_y_.Add(x_cell, y_cell, vehicles_.Y(slot));
+      enemies_cnt_.Add(x_cell, y_cell, 1);
     }
     else {
       // remember potential nuclear strike launcher for this fragment
       have_representatives_in_fragment_[x_cell][y_cell] = true;
-      representatives_in_fragment_[x_cell][y_cell] = vehicle;
+      representatives_in_fragment_[x_cell][y_cell] = vehicles_.Id(slot);
     }
   }
+  force_balance_.Build();
+  enemies_cnt_.Build();
+  enemies_sum_x_.Build();
+  enemies_sum_y_.Build();
 
-  int best_fragment_balance = 0;
-
-  // default to bottom right corner (opponent's initial position)
-  int best_fragment_x = runtime_constants_->kFragmentsLinearCount - 1;
-  int best_fragment_y = runtime_constants_->kFragmentsLinearCount - 1;
-  
-  for (size_t i = 0; i < runtime_constants_->kFragmentsLinearCount; i++) {
-    for (size_t j = 0; j < runtime_constants_->kFragmentsLinearCount; j++) {
-      if (force_balance_by_fragment_[i][j] > best_fragment_balance) {
-        best_fragment_balance = force_balance_by_fragment_[i][j];
-        best_fragment_x = i;
-        best_fragment_y = j;
+  // each chunk of rows of windows finds its best window (in the order of rows)
+  const unsigned int last_window_start = fragments_count - kStrikeWindowLinearCount;
+  const size_t rows_count = last_window_start + 1;
+  const size_t chunks_count = ChunksCount(rows_count);
+  worker_pool_->Run(chunks_count, [&](const size_t chunk, const size_t) {
+    ChunkBest& best = best_by_chunk_[chunk];
+    best = ChunkBest();
+    const unsigned int rows_end = ChunkBegin(chunk + 1, chunks_count, rows_count);
+    for (unsigned int i = ChunkBegin(chunk, chunks_count, rows_count); i < rows_end; i++) {
+      for (unsigned int j = 0; j <= last_window_start; j++) {
+        const int balance = force_balance_.Sum(i, j, i + kStrikeWindowLinearCount, j + kStrikeWindowLinearCount);
+        if (balance > best.balance) {
+          best.balance = balance;
+          best.candidate = i * rows_count + j;
+          best.is_found = true;
+        }
       }
     }
+  });
+  const ChunkBest& best_window = ReduceChunks(chunks_count);
+
+  // default to bottom right corner (opponent's initial position): the window there, not a single fragment
+  unsigned int best_window_x = last_window_start;
+  unsigned int best_window_y = last_window_start;
+  if (best_window.is_found) {
+    best_window_x = best_window.candidate / rows_count;
+    best_window_y = best_window.candidate % rows_count;
   }
 
-  if (cnt_enemies_by_fragment[best_fragment_x][best_fragment_y] > 0) {
-    // return mass center of all enemies within the square with the best balance
-    return sum_enemy_position_by_fragment[best_fragment_x][best_fragment_y] /
-           cnt_enemies_by_fragment[best_fragment_x][best_fragment_y];
+  const unsigned int window_end_x = best_window_x + kStrikeWindowLinearCount;
+  const unsigned int window_end_y = best_window_y + kStrikeWindowLinearCount;
+  const int enemies_cnt = enemies_cnt_.Sum(best_window_x, best_window_y, window_end_x, window_end_y);
+  if (enemies_cnt > 0) {
+    // return mass center of all enemies within the window with the best balance
+    return Vect(enemies_sum_x_.Sum(best_window_x, best_window_y, window_end_x, window_end_y),
+                enemies_sum_y_.Sum(best_window_x, best_window_y, window_end_x, window_end_y)) / enemies_cnt;
   }
 
-  // return top-left corner of the square with the best balance
-  return Vect(best_fragment_x * runtime_constants_->kFragmentSideLength,
-              best_fragment_y * runtime_constants_->kFragmentSideLength);
+  // return center of the window with the best balance
+  // (a window without enemies is aimed at its center rather than at the top left corner of a fragment)
+  return Vect(best_window_x + kStrikeWindowLinearCount / 2.0,
+              best_window_y + kStrikeWindowLinearCount / 2.0) * runtime_constants_->kFragmentSideLength;
 }
 
 void NuclearAttackHandler::TrySendingNuclearCrew(const Player& me, const int current_tick,
                                                  const Vect& launcher_position,
-                                                 std::deque<std::unique_ptr<Action>>& actions) {
+                                                 ActionScheduler& actions) {
   // If nuclear strike will be allowed by the time when nuclear brigade reaches the target
   // and there's no planned actions (so we won't have to wait for long when time for the strike comes)
-  if (me.getRemainingNuclearStrikeCooldownTicks() <= kTimeToDeliverNukes && actions.empty()) {
+  if (me.getRemainingNuclearStrikeCooldownTicks() <= kTimeToDeliverNukes && actions.Empty()) {
     // Don't send Nuclear Crew at the very beginning of the game. Give orders to other vehicles first!
     if (current_tick >= kEarliestNuclearCrewMissionTick &&
         motionlessness_checker_->AreAllVehiclesOfTypeMotionless(model::VehicleType::FIGHTER)) {
@@ -96,80 +133,320 @@ void NuclearAttackHandler::TrySendingNuclearCrew(const Player& me, const int cur
       // select units within a small rectangle with center at the selected Fighter position
       const Vect diagonal = kUnitVector * kNuclearLauncherSelectionSize;
       const Vect top_left = launcher_position - diagonal / 2;
-      actions.push_back(std::make_unique<Select>(top_left, diagonal));
+      actions.StartChain("NuclearCrew", ActionPriority::HIGH);
+      actions.Add(Select(top_left, diagonal));
 
       const Vect point_to_strike = FindSquareWithLargestPotentialForNuclearStrike(me);
-      actions.push_back(std::make_unique<GoTo>(point_to_strike - launcher_position));
+      actions.Add(GoTo(point_to_strike - launcher_position));
     }
   }
 }
 
-void NuclearAttackHandler::TryNuclearStrike(const Player& me,
-                                            std::deque<std::unique_ptr<Action>>& actions) const {
+void NuclearAttackHandler::TryNuclearStrike(const Player& me, const int current_tick,
+                                            ActionScheduler& actions) const {
+  PROFILE_SCOPE(TRY_NUCLEAR_STRIKE);
   if (me.getRemainingNuclearStrikeCooldownTicks() == 0) {
-    // if the first action in the deque is Selection or the deque is Empty,
-    // it means that we finished working with the currently selected troops,
-    // so interfering with Nuclear Strike won't break
-    // any of already existing plans for the currently selected troops
-    if (actions.empty() || actions[0]->Name().find("Select") != std::string::npos) {
-      vector<vector<bool>> tried_nuclear_strike_launcher(
-        runtime_constants_->kDoubledFragmentsLinearCount,
-        vector<bool>(runtime_constants_->kDoubledFragmentsLinearCount, false));
-      int enemies_in_range_best_cnt = 0;
-      int enemies_in_range_best_balance = 0;
-      Vehicle best_launcher;
-      Vect best_sum_position;
-
-      // consider all my vehicles
-      for (const auto& id_and_vehicle : vehicle_by_id_) {
-        const Vehicle& launcher = id_and_vehicle.second;
-        if (launcher.getPlayerId() == me.getId()) {
-          // map vehicle position onto one of the large fragments
-          const int x_cell = launcher.getX() / runtime_constants_->kDoubledFragmentSideLength;
-          const int y_cell = launcher.getY() / runtime_constants_->kDoubledFragmentSideLength;
-          
-          // don't try more than one vehicle as a launcher in each large fragment
-          // (it's a heuristic to speed up the launcher selection process)
-          if (tried_nuclear_strike_launcher[x_cell][y_cell]) {
-            continue;
-          }
-          tried_nuclear_strike_launcher[x_cell][y_cell] = true;
-          
-          int cnt = 0;
-          int balance = 0;
-          Vect sumPosition;
-
-          // consider all vehicles (both mine and opponent's) that may be damaged by the nuclear strike
-          for (const auto& id_and_target_vehicle : vehicle_by_id_) {
-            const Vehicle target = id_and_target_vehicle.second;
-            if (launcher.getDistanceTo(target) < launcher.getVisionRange() / 2) {
-              balance += vehicle_value_estimator_->CalculateVehicleValue(target, me);
-              if (target.getPlayerId() != me.getId()) {
-                cnt++;
-                sumPosition += Vect(target);
-              }
-            }
-          }
-          if (balance > enemies_in_range_best_balance) {
-            enemies_in_range_best_cnt = cnt;
-            enemies_in_range_best_balance = balance;
-            best_launcher = launcher;
-            best_sum_position = sumPosition;
+    // a strike which is already planned is made before any other chain starts
+    // (and a started chain is never interrupted, so the strike doesn't break its plans)
+    if (actions.Size(ActionPriority::URGENT) == 0) {
+      const long long my_id = me.getId();
+
+      // the candidates scored on idle ticks (the rest of them are scored now if there were too few idle ticks)
+      // give the answer for this tick: if no strike is worth making, the next pass will look again;
+      // the chosen launcher is checked against the current state of the world,
+      // and the launcher is chosen from scratch only if it's lost
+      launcher_scoring_.Finish(current_tick);
+      if (launcher_scoring_.HasCompletedPass()) {
+        if (!launcher_scoring_.HasResult()) {
+          return;
+        }
+        const size_t launcher = vehicles_.SlotById(launcher_scoring_.BestLauncherId());
+        launcher_scoring_.Forget();
+        if (launcher != VehicleStore::kNoSlot) {
+          CalculateVehicleValues(my_id, current_tick);
+          const StrikeScore score = ScoreLauncher(launcher, my_id, current_tick, packed_targets_by_worker_[0]);
+          if (score.balance > 0 && score.enemies_cnt >= kMinEnemiesCountDeservingNukes) {
+            OrderNuclearStrike(score, vehicles_.Id(launcher), actions);
           }
+          return;
         }
       }
+
+      vector<pair<long long, size_t>> launchers; // {ID; slot}
+      CollectLauncherCandidates(my_id, launchers);
+      CalculateVehicleValues(my_id, current_tick);
+
+      // each chunk of launchers finds its best candidate (in the order of IDs)
+      const size_t chunks_count = ChunksCount(launchers.size());
+      worker_pool_->Run(chunks_count, [&](const size_t chunk, const size_t worker) {
+        ChunkBest& best = best_by_chunk_[chunk];
+        best = ChunkBest();
+        const size_t launchers_end = ChunkBegin(chunk + 1, chunks_count, launchers.size());
+        for (size_t i = ChunkBegin(chunk, chunks_count, launchers.size()); i < launchers_end; i++) {
+          const StrikeScore score = ScoreLauncher(launchers[i].second, my_id, current_tick,
+                                                  packed_targets_by_worker_[worker]);
+          if (score.balance > best.balance) {
+            best.balance = score.balance;
+            best.score = score;
+            best.candidate = i;
+            best.is_found = true;
+          }
+        }
+      });
+      const ChunkBest& best = ReduceChunks(chunks_count);
+
       // order nuclear strike with the best possible outcome for us, assuming that
       // - it hits the specified minimum number of enemy vehicles,
       // and
       // - the balance is positive.
-      if (enemies_in_range_best_cnt >= kMinEnemiesCountDeservingNukes) {
-        actions.push_front(
-          std::make_unique<NuclearStrike>(best_sum_position / enemies_in_range_best_cnt, best_launcher.getId()));
+      if (best.is_found && best.score.enemies_cnt >= kMinEnemiesCountDeservingNukes) {
+        OrderNuclearStrike(best.score, launchers[best.candidate].first, actions);
       }
     }
   }
 }
 
+void NuclearAttackHandler::PlanLauncherScoring(const Player& me, const int ticks_to_next_planning,
+                                               IdleWorkScheduler& idle_work) {
+  if (me.getRemainingNuclearStrikeCooldownTicks() <= ticks_to_next_planning) {
+    // while the cooldown is over and there's nothing to strike, the same scoring would find nothing again
+    if (!launcher_scoring_.IsEmptyPassUpToDate(kMinChangesToRescoreLaunchers)) {
+      launcher_scoring_.Restart(me.getId());
+      idle_work.Schedule(&launcher_scoring_);
+    }
+  }
+  else {
+    launcher_scoring_.Forget();
+  }
+}
+
+void NuclearAttackHandler::LauncherScoringJob::Restart(const long long my_id) {
+  my_id_ = my_id;
+  handler_.CollectLauncherCandidates(my_id, launchers_);
+  next_launcher_ = 0;
+  best_balance_ = 0;
+  best_launcher_id_ = -1;
+  is_done_ = false;
+  is_active_ = true;
+  changes_at_restart_ = handler_.vehicles_.ChangesCount();
+}
+
+bool NuclearAttackHandler::LauncherScoringJob::RunSlice(const int current_tick) {
+  ScoreNextLaunchers(kLaunchersPerSlice, current_tick);
+  return is_done_;
+}
+
+void NuclearAttackHandler::LauncherScoringJob::Finish(const int current_tick) {
+  ScoreNextLaunchers(launchers_.size(), current_tick);
+}
+
+void NuclearAttackHandler::LauncherScoringJob::ScoreNextLaunchers(const size_t max_count, const int current_tick) {
+  if (is_done_ || next_launcher_ == launchers_.size()) {
+    is_done_ = true;
+    return;
+  }
+  // values and positions are taken from the current tick, launchers are found by their IDs
+  // as slots may have changed since the job started
+  handler_.CalculateVehicleValues(my_id_, current_tick);
+  const size_t end = std::min(launchers_.size(), next_launcher_ + max_count);
+  for (; next_launcher_ < end; next_launcher_++) {
+    const long long launcher_id = launchers_[next_launcher_].first;
+    const size_t launcher = handler_.vehicles_.SlotById(launcher_id);
+    if (launcher == VehicleStore::kNoSlot) {
+      continue;
+    }
+    const StrikeScore score = handler_.ScoreLauncher(launcher, my_id_, current_tick,
+                                                     handler_.packed_targets_by_worker_[0]);
+    if (score.balance > best_balance_) {
+      best_balance_ = score.balance;
+      best_launcher_id_ = launcher_id;
+    }
+  }
+  is_done_ = next_launcher_ == launchers_.size();
+}
+
+bool NuclearAttackHandler::LauncherScoringJob::IsEmptyPassUpToDate(const unsigned long long max_changes) const {
+  return HasCompletedPass() && best_launcher_id_ == -1 &&
+         handler_.vehicles_.ChangesCount() - changes_at_restart_ < max_changes;
+}
+
+void NuclearAttackHandler::LauncherScoringJob::Forget() {
+  best_launcher_id_ = -1;
+  is_active_ = false;
+  // a scheduled job stops at its next slice
+  next_launcher_ = launchers_.size();
+}
+
+void NuclearAttackHandler::CollectLauncherCandidates(const long long my_id,
+                                                     vector<pair<long long, size_t>>& launchers) const {
+  // don't try more than one vehicle as a launcher in each large fragment
+  // (it's a heuristic to speed up the launcher selection process):
+  // the one with the smallest ID represents the fragment
+  const unsigned int scale = cpu_governor_->LauncherFragmentScale();
+  const unsigned int fragment_side_length = runtime_constants_->kDoubledFragmentSideLength * scale;
+  const unsigned int fragments_count = (runtime_constants_->kDoubledFragmentsLinearCount + scale - 1) / scale;
+  vector<vector<size_t>> launcher_slot_by_fragment(
+    fragments_count, vector<size_t>(fragments_count, VehicleStore::kNoSlot));
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+    if (vehicles_.PlayerId(slot) == my_id) {
+      // map vehicle position onto one of the large fragments
+      const int x_cell = vehicles_.X(slot) / fragment_side_length;
+      const int y_cell = vehicles_.Y(slot) / fragment_side_length;
+      size_t& representative = launcher_slot_by_fragment[x_cell][y_cell];
+      if (representative == VehicleStore::kNoSlot || vehicles_.Id(slot) < vehicles_.Id(representative)) {
+        representative = slot;
+      }
+    }
+  }
+  launchers.clear();
+  for (const auto& fragments_column : launcher_slot_by_fragment) {
+    for (const size_t slot : fragments_column) {
+      if (slot != VehicleStore::kNoSlot) {
+        launchers.emplace_back(vehicles_.Id(slot), slot);
+      }
+    }
+  }
+  // candidates are compared in the order of IDs, so ties are broken the same way regardless of storage layout
+  std::sort(launchers.begin(), launchers.end());
+}
+
+void NuclearAttackHandler::CalculateVehicleValues(const long long my_id, const int current_tick) const {
+  // values of all vehicles are calculated once per tick and then reused for every launcher candidate
+  if (value_by_slot_tick_ == current_tick && value_by_slot_.size() == vehicles_.Size()) {
+    return;
+  }
+  value_by_slot_tick_ = current_tick;
+  value_by_slot_.resize(vehicles_.Size());
+  for (size_t slot = 0; slot < vehicles_.Size(); slot++) {
+    value_by_slot_[slot] = vehicle_value_estimator_->CalculateVehicleValue(
+      vehicles_.Durability(slot), vehicles_.MaxDurability(slot), vehicles_.Type(slot),
+      vehicles_.PlayerId(slot) == my_id);
+  }
+}
+
+NuclearAttackHandler::StrikeScore NuclearAttackHandler::ScoreLauncher(const size_t launcher, const long long my_id,
+                                                                      const int current_tick,
+                                                                      PackedTargets& targets) const {
+  const Vect launcher_position = vehicles_.Position(launcher);
+  const double strike_range = vehicles_.VisionRange(launcher) / 2;
+
+  // the strike is aimed at the predicted mass center of the enemies around the launcher
+  PackTargetsAround(launcher_position, strike_range, value_by_slot_, my_id, current_tick, targets);
+  const StrikeScore enemies_around = ScorePackedTargets(launcher_position, strike_range, targets);
+  if (enemies_around.enemies_cnt == 0) {
+    return enemies_around;
+  }
+  const Vect target = enemies_around.enemies_sum_position / enemies_around.enemies_cnt;
+
+  // consider all vehicles (both mine and opponent's) that may be damaged by the strike at that point
+  const double strike_radius = runtime_constants_->kTacticalNuclearStrikeRadius;
+  PackTargetsAround(target, strike_radius, value_by_slot_, my_id, current_tick, targets);
+  StrikeScore score = ScorePackedTargets(target, strike_radius, targets);
+  score.target = target;
+  return score;
+}
+
+void NuclearAttackHandler::OrderNuclearStrike(const StrikeScore& score, const long long launcher_id,
+                                              ActionScheduler& actions) const {
+  // The launcher may lose sight of the target soon, so a late strike is chosen again from scratch
+  actions.StartChain("NuclearStrike", ActionPriority::URGENT, runtime_constants_->kBaseUniformActionInterval);
+  actions.Add(NuclearStrike(score.target, launcher_id));
+}
+
+void NuclearAttackHandler::PackTargetsAround(const Vect& center, const double range,
+                                             const vector<int>& value_by_slot, const long long my_id,
+                                             const int current_tick, PackedTargets& targets) const {
+  targets.x.clear();
+  targets.y.clear();
+  targets.value.clear();
+  targets.is_enemy.clear();
+  // a vehicle may come into the range from farther away before the detonation
+  const double max_shift = runtime_constants_->kMaxVehicleSpeed * runtime_constants_->kTacticalNuclearStrikeDelay;
+  spatial_grid_->ForEachInCellsAround(center, range + max_shift, [&](const size_t slot) {
+    const Vect position = PositionAtDetonation(slot, current_tick);
+    targets.x.push_back(position.x);
+    targets.y.push_back(position.y);
+    targets.value.push_back(value_by_slot[slot]);
+    targets.is_enemy.push_back(vehicles_.PlayerId(slot) != my_id ? 1.0 : 0.0);
+  });
+}
+
+Vect NuclearAttackHandler::PositionAtDetonation(const size_t slot, const int current_tick) const {
+  Vect position = vehicles_.Position(slot) +
+                  vehicles_.Velocity(slot, current_tick) * runtime_constants_->kTacticalNuclearStrikeDelay;
+  // vehicles stop at the borders of the world
+  position.x = std::max(0.0, std::min(static_cast<double>(runtime_constants_->kWorldSideLength), position.x));
+  position.y = std::max(0.0, std::min(static_cast<double>(runtime_constants_->kWorldSideLength), position.y));
+  return position;
+}
+
+NuclearAttackHandler::StrikeScore NuclearAttackHandler::ScorePackedTargets(const Vect& center,
+                                                                           const double range,
+                                                                           const PackedTargets& targets) const {
+  const size_t kLanes = 4;
+  const size_t count = targets.x.size();
+  const double* xs = targets.x.data();
+  const double* ys = targets.y.data();
+  const double* values = targets.value.data();
+  const double* is_enemy = targets.is_enemy.data();
+  const double squared_range = range * range;
+
+  double balance[kLanes] = {};
+  double enemies_cnt[kLanes] = {};
+  double enemies_sum_x[kLanes] = {};
+  double enemies_sum_y[kLanes] = {};
+
+  const auto accumulate = [&](const size_t i, const size_t lane) {
+    const double dx = xs[i] - center.x;
+    const double dy = ys[i] - center.y;
+    const double in_range = dx * dx + dy * dy < squared_range ? 1.0 : 0.0;
+    const double enemy_in_range = in_range * is_enemy[i];
+    balance[lane] += in_range * values[i];
+    enemies_cnt[lane] += enemy_in_range;
+    enemies_sum_x[lane] += enemy_in_range * xs[i];
+    enemies_sum_y[lane] += enemy_in_range * ys[i];
+  };
+
+  size_t i = 0;
+  for (; i + kLanes <= count; i += kLanes) {
+    for (size_t lane = 0; lane < kLanes; lane++) {
+      accumulate(i + lane, lane);
+    }
+  }
+  for (; i < count; i++) {
+    accumulate(i, 0);
+  }
+
+  StrikeScore score;
+  for (size_t lane = 0; lane < kLanes; lane++) {
+    score.balance += static_cast<int>(balance[lane]);
+    score.enemies_cnt += static_cast<int>(enemies_cnt[lane]);
+    score.enemies_sum_position += Vect(enemies_sum_x[lane], enemies_sum_y[lane]);
+  }
+  return score;
+}
+
+size_t NuclearAttackHandler::ChunksCount(const size_t items_count) const {
+  // there's at least one (maybe empty) chunk, so that the reduction always has a result
+  const size_t chunks_count = std::max<size_t>(1, std::min(items_count,
+                                                           worker_pool_->WorkersCount() * kChunksPerWorker));
+  if (best_by_chunk_.size() < chunks_count) {
+    best_by_chunk_.resize(chunks_count);
+  }
+  return chunks_count;
+}
+
+const NuclearAttackHandler::ChunkBest& NuclearAttackHandler::ReduceChunks(const size_t chunks_count) const {
+  size_t best_chunk = 0;
+  for (size_t chunk = 1; chunk < chunks_count; chunk++) {
+    if (best_by_chunk_[chunk].is_found &&
+        (!best_by_chunk_[best_chunk].is_found || best_by_chunk_[chunk].balance > best_by_chunk_[best_chunk].balance)) {
+      best_chunk = chunk;
+    }
+  }
+  return best_by_chunk_[best_chunk];
+}
+
 void NuclearAttackHandler::Clamp(int& x, const int l, const int r) const {
   if (x < l) x = l;
   if (x > r) x = r;
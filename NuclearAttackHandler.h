@@ -3,56 +3,205 @@
 #define _NUCLEAR_ATTACK_HANDLER_H_
 
 #include "Vect.h"
-#include "Action.h"
+#include "ActionScheduler.h"
 #include "VehicleValueEstimator.h"
 #include "RuntimeConstants.h"
 #include "MotionlessnessChecker.h"
-#include <deque>
-#include <map>
+#include "VehicleStore.h"
+#include "SpatialGrid.h"
+#include "SummedAreaTable.h"
+#include "WorkerPool.h"
+#include "IdleWorkScheduler.h"
+#include "CpuGovernor.h"
 #include <vector>
 #include <memory>
 
 class NuclearAttackHandler {
  public:
-  NuclearAttackHandler(const std::map<long long, model::Vehicle>& vehicle_by_id,
+  NuclearAttackHandler(const VehicleStore& vehicles,
+                       const std::shared_ptr<SpatialGrid>& spatial_grid,
                        const std::shared_ptr<VehicleValueEstimator>& vehicle_value_estimator,
                        const std::shared_ptr<RuntimeConstants>& runtime_constants,
-                       const std::shared_ptr<MotionlessnessChecker>& motionlessness_checker);
+                       const std::shared_ptr<MotionlessnessChecker>& motionlessness_checker,
+                       const std::shared_ptr<WorkerPool>& worker_pool,
+                       const std::shared_ptr<const CpuGovernor>& cpu_governor);
 
   // Subdivides the world into <Length-of-the-world-side> equal squares.
-  // Chooses the one where the nuclear strike will be the most effective (more damage for opponent, less damage for us).
-  // Returns coordinates of a point inside that square.
+  // Slides a window of squares matching the diameter of the nuclear strike over the whole world
+  // (every window is scored in O(1) with summed-area tables, rows of windows are scored in parallel)
+  // and chooses the one where the nuclear strike will be the most effective
+  // (more damage for opponent, less damage for us).
+  // Returns coordinates of a point inside that window.
   Vect FindSquareWithLargestPotentialForNuclearStrike(const model::Player& me);
 
   // If nuclear strike is possible soon,
   // selects a small group of fighters and
   // sends them to the square with the largest potential for nuclear strike.
   void TrySendingNuclearCrew(const model::Player& me, const int current_tick,
-                             const Vect& launcher_position, std::deque<std::unique_ptr<Action>>& actions);
+                             const Vect& launcher_position, ActionScheduler& actions);
 
   // If nuclear strike is possible right now and will bring enough damage,
   // this method orders it immediately.
-  void TryNuclearStrike(const model::Player& me, std::deque<std::unique_ptr<Action>>& actions) const;
+  // Vehicles are expected to keep moving with their current velocities (see VehicleStore::Velocity),
+  // so the strike is scored and aimed at their positions at the moment of detonation.
+  // Launcher candidates are scored in parallel, the choice doesn't depend on the number of workers.
+  // If the candidates have been scored on idle ticks (see PlanLauncherScoring), their choice is the answer,
+  // and the candidates are scored from scratch only if the chosen launcher is lost.
+  void TryNuclearStrike(const model::Player& me, const int current_tick, ActionScheduler& actions) const;
+
+  // If a strike may be possible by the next planning tick,
+  // schedules scoring of launcher candidates on the idle ticks before it.
+  // A scoring which has found nothing is kept while the world stays almost the same.
+  void PlanLauncherScoring(const model::Player& me, const int ticks_to_next_planning, IdleWorkScheduler& idle_work);
+
+  // Whether scoring on idle ticks has found a launcher whose strike is worth making
+  bool HasPreparedLauncher() const { return launcher_scoring_.HasResult(); }
 
  private:
+  // Expected outcome of a nuclear strike
+  struct StrikeScore {
+    int balance = 0;
+    int enemies_cnt = 0;
+    Vect enemies_sum_position;
+    Vect target; // the point to strike
+  };
+
+  // Properties of the vehicles that may be reached by a strike, copied into contiguous buffers
+  struct PackedTargets {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> value;
+    std::vector<double> is_enemy;
+  };
+
+  // The best candidate found in a chunk of candidates (a launcher or a window of fragments)
+  struct ChunkBest {
+    int balance = 0;
+    StrikeScore score;
+    size_t candidate = 0;
+    bool is_found = false;
+  };
+
+  // Scores the launcher candidates a few at a time, keeping the best one by ID
+  class LauncherScoringJob : public IdleJob {
+   public:
+    explicit LauncherScoringJob(const NuclearAttackHandler& handler) : handler_(handler) {}
+
+    void Restart(const long long my_id);
+    bool RunSlice(const int current_tick) override;
+    // Scores all the candidates left at once
+    void Finish(const int current_tick);
+
+    // Whether the job has scored all of its candidates since it was restarted (and not forgotten)
+    bool HasCompletedPass() const { return is_active_ && is_done_; }
+    // Whether the completed pass has found a launcher with positive balance
+    bool HasResult() const { return HasCompletedPass() && best_launcher_id_ != -1; }
+    // Whether the completed pass has found nothing and fewer than `max_changes` vehicle states
+    // have changed since it started
+    bool IsEmptyPassUpToDate(const unsigned long long max_changes) const;
+    long long BestLauncherId() const { return best_launcher_id_; }
+
+    // Drops the result (or stops the job), so that it's not used after the world has changed
+    void Forget();
+
+   private:
+    static const size_t kLaunchersPerSlice = 8;
+
+    // Velocities are taken as of `current_tick`, the tick the slice runs on
+    void ScoreNextLaunchers(const size_t max_count, const int current_tick);
+
+    const NuclearAttackHandler& handler_;
+    long long my_id_ = -1;
+    std::vector<std::pair<long long, size_t>> launchers_; // {ID; slot at the start of the job}
+    size_t next_launcher_ = 0;
+    int best_balance_ = 0;
+    long long best_launcher_id_ = -1;
+    bool is_done_ = false;
+    bool is_active_ = false; // restarted and not forgotten since then
+    unsigned long long changes_at_restart_ = 0; // VehicleStore::ChangesCount() when restarted
+  };
+
+  // Fills `launchers` with {ID; slot} of my vehicles to try as launchers, ordered by ID
+  // (one per fragment, fragments are larger if CpuGovernor has lowered the quality)
+  void CollectLauncherCandidates(const long long my_id, std::vector<std::pair<long long, size_t>>& launchers) const;
+
+  // Fills value_by_slot_ for the current state of all vehicles, once per tick
+  // (vehicles change only between ticks)
+  void CalculateVehicleValues(const long long my_id, const int current_tick) const;
+
+  // Aims a strike by the launcher in the slot at the predicted mass center of the enemies around it
+  // and scores the strike at that point (value_by_slot_ must be up to date)
+  StrikeScore ScoreLauncher(const size_t launcher, const long long my_id, const int current_tick,
+                            PackedTargets& targets) const;
+
+  void OrderNuclearStrike(const StrikeScore& score, const long long launcher_id, ActionScheduler& actions) const;
+
+  // Copies properties of all vehicles that may be reached by a strike at `center` into packed buffers
+  // (with their positions at the moment of detonation)
+  void PackTargetsAround(const Vect& center, const double range, const std::vector<int>& value_by_slot,
+                         const long long my_id, const int current_tick, PackedTargets& targets) const;
+
+  // Position of the vehicle in the slot after the strike delay, if it keeps its current velocity
+  Vect PositionAtDetonation(const size_t slot, const int current_tick) const;
+
+  // Scores a strike at `center` over the packed buffers.
+  // The loop is branch-free and keeps independent accumulators, so that the compiler can vectorize it.
+  StrikeScore ScorePackedTargets(const Vect& center, const double range, const PackedTargets& targets) const;
+
+  // Number of contiguous chunks `items_count` candidates are split into for the workers (at least one)
+  size_t ChunksCount(const size_t items_count) const;
+  static size_t ChunkBegin(const size_t chunk, const size_t chunks_count, const size_t items_count) {
+    return chunk * items_count / chunks_count;
+  }
+
+  // Picks the best of the chunks' bests, taking the earliest chunk on ties
+  // (so the result is the same as of a sequential scan over all candidates)
+  const ChunkBest& ReduceChunks(const size_t chunks_count) const;
+
   // Changes `x` to the closest integer from [l; r] segment
   void Clamp(int& x, const int l, const int r) const;
 
   const int kEarliestNuclearCrewMissionTick = 100;
   const int kTimeToDeliverNukes = 50;
   const int kMinEnemiesCountDeservingNukes = 10;
+  // A scoring which has found nothing isn't repeated until this many vehicle states have changed
+  const unsigned long long kMinChangesToRescoreLaunchers = 10;
 
   const int kNuclearLauncherSelectionSize = 30;
 
-  const std::map<long long, model::Vehicle>& vehicle_by_id_;
+  // More chunks than workers even out the work of the workers which get crowded areas
+  const size_t kChunksPerWorker = 4;
 
-  std::vector<std::vector<model::Vehicle>> representatives_in_fragment_;
+  const VehicleStore& vehicles_;
+  const std::shared_ptr<SpatialGrid> spatial_grid_;
+
+  const std::shared_ptr<WorkerPool> worker_pool_;
+  const std::shared_ptr<const CpuGovernor> cpu_governor_;
+
+  // Scratch buffers reused between calls, so that launcher evaluation doesn't allocate memory
+  mutable std::vector<int> value_by_slot_;
+  mutable int value_by_slot_tick_ = -1; // the tick value_by_slot_ is calculated for
+  mutable std::vector<PackedTargets> packed_targets_by_worker_;
+  mutable std::vector<ChunkBest> best_by_chunk_;
+
+  // The launcher choice prepared on idle ticks (it's dropped once used)
+  mutable LauncherScoringJob launcher_scoring_;
+
+  std::vector<std::vector<long long>> representatives_in_fragment_; // vehicle IDs
   std::vector<std::vector<bool>> have_representatives_in_fragment_;
-  std::vector<std::vector<int>> force_balance_by_fragment_;
 
   std::shared_ptr<VehicleValueEstimator> vehicle_value_estimator_;
   const std::shared_ptr<RuntimeConstants> runtime_constants_;
   const std::shared_ptr<MotionlessnessChecker> motionlessness_checker_;
+
+  // Side of the window (in fragments) which covers the area of a nuclear strike
+  const unsigned int kStrikeWindowLinearCount;
+
+  // Per-fragment totals turned into prefix sums
+  SummedAreaTable<int> force_balance_;
+  SummedAreaTable<int> enemies_cnt_;
+  SummedAreaTable<double> enemies_sum_x_;
+  SummedAreaTable<double> enemies_sum_y_;
 };
 
 #endif
@@ -9,6 +9,10 @@ void NuclearStrike::Execute(model::Move& move) const {
   move.setY(target_.y);
 }
 
-std::string NuclearStrike::Name() const {
+const char* NuclearStrike::Name() const {
   return "NuclearStrike";
 }
+
+bool NuclearStrike::operator == (const NuclearStrike& other) const {
+  return target_ == other.target_ && launcher_id_ == other.launcher_id_;
+}
@@ -2,15 +2,15 @@
 #ifndef _NUCLEAR_STRIKE_H_
 #define _NUCLEAR_STRIKE_H_
 
-#include "Action.h"
 #include "Vect.h"
 
 // Orders vehicle with <launcher_id> to deliver Nuclear Strike at <target>
-class NuclearStrike : public Action {
+class NuclearStrike {
  public:
 	NuclearStrike(const Vect& target, const long long launcher_id);	
-	void Execute(model::Move& move) const override;
-	std::string Name() const override;
+	void Execute(model::Move& move) const;
+	const char* Name() const;
+	bool operator == (const NuclearStrike& other) const;
 
  private:
 	Vect target_;
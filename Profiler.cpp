@@ -0,0 +1,103 @@
+#include "Profiler.h"
+
+#include <algorithm>
+
+Profiler& Profiler::Instance() {
+  static Profiler profiler;
+  return profiler;
+}
+
+Profiler::Profiler() {
+  Reset();
+}
+
+void Profiler::Record(const ProfiledPhase& phase, const std::int64_t nanoseconds) {
+  Histogram& histogram = histograms_[static_cast<size_t>(phase)];
+  histogram.counts[BucketIndex(nanoseconds)]++;
+  histogram.calls++;
+  histogram.total_nanoseconds += nanoseconds;
+  histogram.max_nanoseconds = std::max(histogram.max_nanoseconds, nanoseconds);
+}
+
+void Profiler::PrintSummary(std::FILE* output) const {
+  const double kNanosecondsInMicrosecond = 1e3;
+  const double kNanosecondsInMillisecond = 1e6;
+  std::fprintf(output, "%-28s %10s %12s %10s %10s %10s %10s\n",
+          "phase", "calls", "total_ms", "mean_us", "p50_us", "p99_us", "max_us");
+  for (size_t i = 0; i < histograms_.size(); i++) {
+    const Histogram& histogram = histograms_[i];
+    if (histogram.calls == 0) {
+      continue;
+    }
+    std::fprintf(output, "%-28s %10llu %12.3f %10.2f %10.2f %10.2f %10.2f\n",
+            PhaseName(static_cast<ProfiledPhase>(i)),
+            static_cast<unsigned long long>(histogram.calls),
+            histogram.total_nanoseconds / kNanosecondsInMillisecond,
+            histogram.total_nanoseconds / kNanosecondsInMicrosecond / histogram.calls,
+            Percentile(histogram, 0.5) / kNanosecondsInMicrosecond,
+            Percentile(histogram, 0.99) / kNanosecondsInMicrosecond,
+            histogram.max_nanoseconds / kNanosecondsInMicrosecond);
+  }
+}
+
+void Profiler::Reset() {
+  for (Histogram& histogram : histograms_) {
+    histogram.counts.fill(0);
+    histogram.calls = 0;
+    histogram.total_nanoseconds = 0;
+    histogram.max_nanoseconds = 0;
+  }
+}
+
+// Values below kSubBucketsPerOctave get a bucket each;
+// larger ones are bucketed by their highest bit and the next kSubBucketBits bits
+int Profiler::BucketIndex(const std::int64_t nanoseconds) {
+  const std::uint64_t value = static_cast<std::uint64_t>(std::max<std::int64_t>(nanoseconds, 0));
+  if (value < kSubBucketsPerOctave) {
+    return static_cast<int>(value);
+  }
+  int highest_bit = 63;
+  while (!(value >> highest_bit)) {
+    highest_bit--;
+  }
+  const int octave = highest_bit - kSubBucketBits + 1;
+  const int sub_bucket = static_cast<int>((value >> (highest_bit - kSubBucketBits)) & (kSubBucketsPerOctave - 1));
+  return std::min(octave * kSubBucketsPerOctave + sub_bucket, kBucketsCount - 1);
+}
+
+std::int64_t Profiler::BucketUpperBound(const int bucket) {
+  const int octave = bucket / kSubBucketsPerOctave;
+  const int sub_bucket = bucket % kSubBucketsPerOctave;
+  if (octave == 0) {
+    return sub_bucket;
+  }
+  return (static_cast<std::int64_t>(kSubBucketsPerOctave + sub_bucket + 1) << (octave - 1)) - 1;
+}
+
+std::int64_t Profiler::Percentile(const Histogram& histogram, const double quantile) {
+  const std::uint64_t rank = static_cast<std::uint64_t>(quantile * (histogram.calls - 1)) + 1;
+  std::uint64_t seen = 0;
+  for (int bucket = 0; bucket < kBucketsCount; bucket++) {
+    seen += histogram.counts[bucket];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(bucket), histogram.max_nanoseconds);
+    }
+  }
+  return histogram.max_nanoseconds;
+}
+
+const char* Profiler::PhaseName(const ProfiledPhase& phase) {
+  switch (phase) {
+    case ProfiledPhase::MOVE: return "Move";
+    case ProfiledPhase::INITIALIZE_TICK: return "InitializeTick";
+    case ProfiledPhase::CHECK_MOTIONLESSNESS: return "CheckMyVehiclesMotionlessness";
+    case ProfiledPhase::NUCLEAR_OPERATIONS: return "NuclearOperations";
+    case ProfiledPhase::MAKE_DECISIONS: return "MakeDecisions";
+    case ProfiledPhase::FIND_NUCLEAR_STRIKE_SQUARE: return "FindSquareForNuclearStrike";
+    case ProfiledPhase::TRY_NUCLEAR_STRIKE: return "TryNuclearStrike";
+    case ProfiledPhase::OPTIMIZE_ACTIONS: return "OptimizeActions";
+    case ProfiledPhase::IDLE_WORK: return "IdleWork";
+    case ProfiledPhase::CHAIN_PLANNING: return "ChainPlanning";
+    default: return "Unknown";
+  }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Phases of a tick whose durations are measured
+enum class ProfiledPhase {
+  MOVE = 0,                  // the whole MyStrategy::move()
+  INITIALIZE_TICK,
+  CHECK_MOTIONLESSNESS,
+  NUCLEAR_OPERATIONS,
+  MAKE_DECISIONS,
+  FIND_NUCLEAR_STRIKE_SQUARE,
+  TRY_NUCLEAR_STRIKE,
+  OPTIMIZE_ACTIONS,
+  IDLE_WORK,                 // slices of jobs run between planning ticks
+  CHAIN_PLANNING,            // rollouts of candidate action chains
+  _COUNT_
+};
+
+// Collects durations of tick phases into fixed-size latency histograms
+// (no memory is allocated while the game goes on) and prints a per-game summary.
+// Measurements are taken with PROFILE_SCOPE, which compiles to nothing
+// unless the strategy is built with MY_STRATEGY_PROFILING defined.
+class Profiler {
+ public:
+  static Profiler& Instance();
+
+  void Record(const ProfiledPhase& phase, const std::int64_t nanoseconds);
+
+  // Prints number of calls, total time, mean, median, 99th percentile and maximum for each phase
+  void PrintSummary(std::FILE* output) const;
+
+  void Reset();
+
+ private:
+  // Each power of two is split into kSubBucketsPerOctave buckets of equal width,
+  // so percentiles are reported with an error of at most 1 / kSubBucketsPerOctave
+  static const int kSubBucketBits = 2;
+  static const int kSubBucketsPerOctave = 1 << kSubBucketBits;
+  static const int kBucketsCount = 64 * kSubBucketsPerOctave;
+
+  struct Histogram {
+    std::array<std::uint32_t, kBucketsCount> counts;
+    std::uint64_t calls;
+    std::int64_t total_nanoseconds;
+    std::int64_t max_nanoseconds;
+  };
+
+  static int BucketIndex(const std::int64_t nanoseconds);
+  static std::int64_t BucketUpperBound(const int bucket);
+
+  // Upper bound of the bucket containing the given quantile
+  static std::int64_t Percentile(const Histogram& histogram, const double quantile);
+
+  static const char* PhaseName(const ProfiledPhase& phase);
+
+  Profiler();
+
+  std::array<Histogram, static_cast<size_t>(ProfiledPhase::_COUNT_)> histograms_;
+};
+
+// Measures time between its construction and destruction with a monotonic clock
+class ScopedTimer {
+ public:
+  explicit ScopedTimer(const ProfiledPhase& phase) : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+
+  ~ScopedTimer() {
+    const auto duration = std::chrono::steady_clock::now() - start_;
+    Profiler::Instance().Record(phase_, std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  }
+
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  const ProfiledPhase phase_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+#define PROFILE_CONCATENATE_IMPL(a, b) a##b
+#define PROFILE_CONCATENATE(a, b) PROFILE_CONCATENATE_IMPL(a, b)
+
+// Measures the rest of the enclosing scope as the given ProfiledPhase
+#ifdef MY_STRATEGY_PROFILING
+#define PROFILE_SCOPE(phase) const ScopedTimer PROFILE_CONCATENATE(scoped_timer_, __LINE__)(ProfiledPhase::phase)
+#else
+#define PROFILE_SCOPE(phase)
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef _RING_BUFFER_H_
+#define _RING_BUFFER_H_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Double-ended queue over a single circular array.
+// Memory is allocated only when the queue outgrows its capacity (which is then doubled),
+// so a queue of a steady size doesn't allocate at all.
+// The interface mirrors the subset of std::deque used by the strategy.
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(const size_t initial_capacity = kDefaultCapacity)
+      : storage_(RoundUpToPowerOfTwo(initial_capacity)) {}
+
+  ~RingBuffer() { clear(); }
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  void push_back(const T& value) {
+    if (size_ == storage_.size()) {
+      Grow();
+    }
+    new (Slot(size_)) T(value);
+    size_++;
+  }
+
+  void pop_front() {
+    Slot(0)->~T();
+    head_ = (head_ + 1) & Mask();
+    size_--;
+  }
+
+  void pop_back() {
+    Slot(size_ - 1)->~T();
+    size_--;
+  }
+
+  void clear() {
+    while (size_ > 0) {
+      pop_back();
+    }
+    head_ = 0;
+  }
+
+  T& front() { return *Slot(0); }
+  const T& front() const { return *Slot(0); }
+  T& back() { return *Slot(size_ - 1); }
+  const T& back() const { return *Slot(size_ - 1); }
+  T& operator[](const size_t index) { return *Slot(index); }
+  const T& operator[](const size_t index) const { return *Slot(index); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  size_t capacity() const { return storage_.size(); }
+
+ private:
+  using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  static const size_t kDefaultCapacity = 64;
+
+  static size_t RoundUpToPowerOfTwo(const size_t value) {
+    size_t result = 1;
+    while (result < value) {
+      result *= 2;
+    }
+    return result;
+  }
+
+  size_t Mask() const { return storage_.size() - 1; }
+
+  T* Slot(const size_t index) { return reinterpret_cast<T*>(&storage_[(head_ + index) & Mask()]); }
+  const T* Slot(const size_t index) const {
+    return reinterpret_cast<const T*>(&storage_[(head_ + index) & Mask()]);
+  }
+
+  // Doubles the capacity, moving the elements to the beginning of the new array
+  void Grow() {
+    std::vector<Storage> grown(storage_.size() * 2);
+    for (size_t i = 0; i < size_; i++) {
+      new (&grown[i]) T(std::move(*Slot(i)));
+      Slot(i)->~T();
+    }
+    storage_.swap(grown);
+    head_ = 0;
+  }
+
+  std::vector<Storage> storage_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+};
+
+#endif
@@ -9,6 +9,10 @@ void Rotate::Execute(model::Move& move) const {
   move.setY(center_.y);
 }
 
-std::string Rotate::Name() const {
+const char* Rotate::Name() const {
   return "Rotate";
 }
+
+bool Rotate::operator == (const Rotate& other) const {
+  return angle_ == other.angle_ && center_ == other.center_;
+}
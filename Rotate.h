@@ -2,15 +2,15 @@
 #ifndef _ROTATE_H_
 #define _ROTATE_H_
 
-#include "Action.h"
 #include "Vect.h"
 
 // Orders current selection to rotate around <center> by <angle> radians
-class Rotate : public Action {
+class Rotate {
  public:
   Rotate(const double angle, const Vect& center);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  bool operator == (const Rotate& other) const;
 
  private:
   double angle_;
@@ -1,4 +1,5 @@
 #include "RuntimeConstants.h"
+#include <algorithm>
 #include <cmath>
 
 RuntimeConstants::RuntimeConstants(const model::World& world, const model::Game& game)
@@ -8,4 +9,8 @@ RuntimeConstants::RuntimeConstants(const model::World& world, const model::Game&
       kDoubledFragmentSideLength(kFragmentSideLength * 2),
       kDoubledFragmentsLinearCount(kFragmentsLinearCount / 2),
       kWorldCenter(Vect(kWorldSideLength / 2, kWorldSideLength / 2)),
+      kTacticalNuclearStrikeRadius(game.getTacticalNuclearStrikeRadius()),
+      kTacticalNuclearStrikeDelay(game.getTacticalNuclearStrikeDelay()),
+      kMaxVehicleSpeed(std::max({ game.getArrvSpeed(), game.getFighterSpeed(), game.getHelicopterSpeed(),
+                                  game.getIfvSpeed(), game.getTankSpeed() })),
       kBaseUniformActionInterval(game.getActionDetectionInterval() / game.getBaseActionCount()) {}
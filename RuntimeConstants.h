@@ -18,6 +18,10 @@ class RuntimeConstants {
 
   const Vect kWorldCenter;
 
+  const double kTacticalNuclearStrikeRadius;
+  const int kTacticalNuclearStrikeDelay; // ticks between the order and the detonation
+  const double kMaxVehicleSpeed; // speed of the fastest vehicle type (before terrain and weather factors)
+
   const int kBaseUniformActionInterval; // Required (by rules) pause between two consecutive actions
                                         // if a player wants to spend action points uniformly and 
                                         // doesn't control any Command Center (i.e. doesn't have bonuses)
@@ -9,6 +9,10 @@ void Scale::Execute(model::Move& move) const {
   move.setY(center_.y);
 }
 
-std::string Scale::Name() const {
+const char* Scale::Name() const {
   return "Scale";
 }
+
+bool Scale::operator == (const Scale& other) const {
+  return factor_ == other.factor_ && center_ == other.center_;
+}
@@ -2,18 +2,18 @@
 #ifndef _SCALE_H_
 #define _SCALE_H_
 
-#include "Action.h"
 #include "Vect.h"
 
 // Scales the current selection
 // relative to <center>
 // with a specific scale <factor>
 // (according to the rules: 0.1 <= factor <= 10)
-class Scale : public Action {
+class Scale {
  public:
   Scale(const double factor, const Vect& center);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  bool operator == (const Scale& other) const;
 
  private:
   double factor_;
@@ -11,6 +11,10 @@ void Select::Execute(model::Move& move) const {
   move.setBottom(bottom_right_corner.y);
 }
 
-std::string Select::Name() const {
+const char* Select::Name() const {
   return "Select";
 }
+
+bool Select::operator == (const Select& other) const {
+  return top_left_corner_ == other.top_left_corner_ && diagonal_ == other.diagonal_;
+}
@@ -2,15 +2,15 @@
 #ifndef _SELECT_H_
 #define _SELECT_H_
 
-#include "Action.h"
 #include "Vect.h"
 
 // Selects all vehicles within rectangle with specified <top-left-corner> and <diagonal>
-class Select : public Action {
+class Select {
  public:
   Select(const Vect& top_left, const Vect& diagonal);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  bool operator == (const Select& other) const;
 
  private:
   Vect top_left_corner_;
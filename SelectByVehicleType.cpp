@@ -13,6 +13,10 @@ void SelectByVehicleType::Execute(model::Move& move) const {
   move.setVehicleType(vehicle_type_);
 }
 
-std::string SelectByVehicleType::Name() const {
+const char* SelectByVehicleType::Name() const {
   return "SelectByVehicleType";
 }
+
+bool SelectByVehicleType::operator == (const SelectByVehicleType& other) const {
+  return vehicle_type_ == other.vehicle_type_ && world_side_length_ == other.world_side_length_;
+}
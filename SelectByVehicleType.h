@@ -2,14 +2,16 @@
 #ifndef _SELECT_BY_VEHICLE_TYPE_H_
 #define _SELECT_BY_VEHICLE_TYPE_H_
 
-#include "Action.h"
+#include "Strategy.h"
 
 // Selects all vehicles of a specific type
-class SelectByVehicleType : public Action {
+class SelectByVehicleType {
  public:
   SelectByVehicleType(const model::VehicleType& vehicle_type, const int world_side_length);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  model::VehicleType GetVehicleType() const { return vehicle_type_; }
+  bool operator == (const SelectByVehicleType& other) const;
 
  private:
   model::VehicleType vehicle_type_;
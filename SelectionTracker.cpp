@@ -0,0 +1,37 @@
+#include "SelectionTracker.h"
+
+using namespace model;
+
+SelectionTracker::SelectionTracker(const VehicleStore& vehicles, const long long my_id)
+    : vehicles_(vehicles), my_id_(my_id) {}
+
+void SelectionTracker::RegisterAction(const Action& action) {
+  switch (action.GetKind()) {
+    case Action::Kind::SELECT_BY_VEHICLE_TYPE:
+      is_selection_known_ = true;
+      selected_types_ = TypeBit(action.SelectedVehicleType());
+      break;
+    case Action::Kind::ADD_TO_SELECTION_BY_VEHICLE_TYPE:
+      selected_types_ |= TypeBit(action.SelectedVehicleType());
+      break;
+    case Action::Kind::SELECT:
+      is_selection_known_ = false;
+      break;
+    default:
+      break;
+  }
+}
+
+bool SelectionTracker::AreExactlySelected(const unsigned int types) const {
+  if (!is_selection_known_ || selected_types_ != types) {
+    return false;
+  }
+  for (int i = 0; i < static_cast<int>(VehicleType::_COUNT_); i++) {
+    const VehicleType type = static_cast<VehicleType>(i);
+    const int expected_count = (types & TypeBit(type)) != 0 ? vehicles_.CountByType(my_id_, type) : 0;
+    if (vehicles_.SelectedCountByType(my_id_, type) != expected_count) {
+      return false;
+    }
+  }
+  return true;
+}
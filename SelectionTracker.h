@@ -0,0 +1,36 @@
+#pragma once
+#ifndef _SELECTION_TRACKER_H_
+#define _SELECTION_TRACKER_H_
+
+#include "Strategy.h"
+#include "Action.h"
+#include "VehicleStore.h"
+
+// Keeps track of the selection the game keeps for me, so that selections repeating it can be skipped.
+// The set of selected vehicle types is modelled from the executed actions,
+// and it is trusted only while isSelected flags of my vehicles (received in updates) agree with it:
+// all my vehicles of the selected types are selected and none of the other ones.
+// Selections by rectangle are not modelled, as their result depends on positions at the moment of selection.
+class SelectionTracker {
+ public:
+  SelectionTracker(const VehicleStore& vehicles, const long long my_id);
+
+  // Must be called for each action made
+  void RegisterAction(const Action& action);
+
+  // Whether exactly my vehicles of the types (a bit per type, see TypeBit()) are selected
+  bool AreExactlySelected(const unsigned int types) const;
+
+  static unsigned int TypeBit(const model::VehicleType& vehicle_type) {
+    return 1u << static_cast<unsigned int>(vehicle_type);
+  }
+
+ private:
+  const VehicleStore& vehicles_;
+  const long long my_id_;
+
+  bool is_selection_known_ = false;
+  unsigned int selected_types_ = 0;
+};
+
+#endif
@@ -9,6 +9,10 @@ void SetupVehicleProduction::Execute(model::Move& move) const {
   move.setVehicleType(vehicle_type_);
 }
 
-std::string SetupVehicleProduction::Name() const {
+const char* SetupVehicleProduction::Name() const {
   return "SetupVehicleProduction";
 }
+
+bool SetupVehicleProduction::operator == (const SetupVehicleProduction& other) const {
+  return factory_id_ == other.factory_id_ && vehicle_type_ == other.vehicle_type_;
+}
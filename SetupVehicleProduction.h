@@ -2,14 +2,15 @@
 #ifndef _SETUP_VEHICLE_PRODUCTION_H_
 #define _SETUP_VEHICLE_PRODUCTION_H_
 
-#include "Action.h"
+#include "Strategy.h"
 
 // Starts producing vehicles of specified type on the factory with specified ID
-class SetupVehicleProduction : public Action {
+class SetupVehicleProduction {
  public:
   SetupVehicleProduction(const long long factory_id, const model::VehicleType& vehicle_type);
-  void Execute(model::Move& move) const override;
-  std::string Name() const override;
+  void Execute(model::Move& move) const;
+  const char* Name() const;
+  bool operator == (const SetupVehicleProduction& other) const;
 
  private:
   long long factory_id_;
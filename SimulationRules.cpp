@@ -0,0 +1,83 @@
+#include "SimulationRules.h"
+
+using namespace model;
+
+SimulationRules::SimulationRules(const World& world, const Game& game)
+    : world_side_length_(static_cast<float>(world.getWidth())),
+      vehicle_radius_(static_cast<float>(game.getVehicleRadius())),
+      repair_range_(static_cast<float>(game.getArrvRepairRange())),
+      repair_speed_(static_cast<float>(game.getArrvRepairSpeed())),
+      nuclear_strike_radius_(static_cast<float>(game.getTacticalNuclearStrikeRadius())),
+      max_nuclear_strike_damage_(static_cast<float>(game.getMaxTacticalNuclearStrikeDamage())),
+      nuclear_strike_delay_(game.getTacticalNuclearStrikeDelay()) {
+  const auto type_rules = [](const bool is_aerial, const double speed,
+                             const double ground_attack_range, const double aerial_attack_range,
+                             const int ground_damage, const int aerial_damage,
+                             const int ground_defence, const int aerial_defence, const int attack_cooldown_ticks) {
+    return TypeRules{ is_aerial, static_cast<float>(speed),
+                      static_cast<float>(ground_attack_range), static_cast<float>(aerial_attack_range),
+                      static_cast<float>(ground_damage), static_cast<float>(aerial_damage),
+                      static_cast<float>(ground_defence), static_cast<float>(aerial_defence),
+                      attack_cooldown_ticks };
+  };
+  // ARRVs don't attack
+  type_rules_[static_cast<size_t>(VehicleType::ARRV)] = type_rules(
+    false, game.getArrvSpeed(), 0, 0, 0, 0, game.getArrvGroundDefence(), game.getArrvAerialDefence(), 0);
+  type_rules_[static_cast<size_t>(VehicleType::FIGHTER)] = type_rules(
+    true, game.getFighterSpeed(), game.getFighterGroundAttackRange(), game.getFighterAerialAttackRange(),
+    game.getFighterGroundDamage(), game.getFighterAerialDamage(),
+    game.getFighterGroundDefence(), game.getFighterAerialDefence(), game.getFighterAttackCooldownTicks());
+  type_rules_[static_cast<size_t>(VehicleType::HELICOPTER)] = type_rules(
+    true, game.getHelicopterSpeed(), game.getHelicopterGroundAttackRange(), game.getHelicopterAerialAttackRange(),
+    game.getHelicopterGroundDamage(), game.getHelicopterAerialDamage(),
+    game.getHelicopterGroundDefence(), game.getHelicopterAerialDefence(), game.getHelicopterAttackCooldownTicks());
+  type_rules_[static_cast<size_t>(VehicleType::IFV)] = type_rules(
+    false, game.getIfvSpeed(), game.getIfvGroundAttackRange(), game.getIfvAerialAttackRange(),
+    game.getIfvGroundDamage(), game.getIfvAerialDamage(),
+    game.getIfvGroundDefence(), game.getIfvAerialDefence(), game.getIfvAttackCooldownTicks());
+  type_rules_[static_cast<size_t>(VehicleType::TANK)] = type_rules(
+    false, game.getTankSpeed(), game.getTankGroundAttackRange(), game.getTankAerialAttackRange(),
+    game.getTankGroundDamage(), game.getTankAerialDamage(),
+    game.getTankGroundDefence(), game.getTankAerialDefence(), game.getTankAttackCooldownTicks());
+
+  max_speed_ = 0;
+  max_interaction_range_ = std::max(repair_range_, 2 * vehicle_radius_);
+  for (const TypeRules& rules : type_rules_) {
+    max_speed_ = std::max(max_speed_, rules.speed);
+    max_interaction_range_ = std::max(max_interaction_range_,
+                                      std::max(rules.ground_attack_range, rules.aerial_attack_range));
+  }
+
+  for (size_t attacker = 0; attacker < kNumberOfVehicleTypes; attacker++) {
+    for (size_t target = 0; target < kNumberOfVehicleTypes; target++) {
+      const TypeRules& attacker_rules = type_rules_[attacker];
+      const TypeRules& target_rules = type_rules_[target];
+      const float damage = target_rules.is_aerial ? attacker_rules.aerial_damage : attacker_rules.ground_damage;
+      const float defence = attacker_rules.is_aerial ? target_rules.aerial_defence : target_rules.ground_defence;
+      damage_by_types_[attacker][target] = std::max(0.0f, damage - defence);
+    }
+  }
+
+  const auto& terrain = world.getTerrainByCellXY();
+  const auto& weather = world.getWeatherByCellXY();
+  cells_linear_count_ = static_cast<int>(std::min(terrain.size(), weather.size()));
+  cell_side_length_ = cells_linear_count_ > 0 ? world_side_length_ / cells_linear_count_ : world_side_length_;
+  ground_speed_factor_by_cell_.assign(std::max(1, cells_linear_count_ * cells_linear_count_), 1.0f);
+  aerial_speed_factor_by_cell_.assign(std::max(1, cells_linear_count_ * cells_linear_count_), 1.0f);
+  for (int x = 0; x < cells_linear_count_; x++) {
+    for (int y = 0; y < cells_linear_count_; y++) {
+      const size_t cell = static_cast<size_t>(x) * cells_linear_count_ + y;
+      switch (terrain[x][y]) {
+        case TerrainType::SWAMP: ground_speed_factor_by_cell_[cell] = game.getSwampTerrainSpeedFactor(); break;
+        case TerrainType::FOREST: ground_speed_factor_by_cell_[cell] = game.getForestTerrainSpeedFactor(); break;
+        default: ground_speed_factor_by_cell_[cell] = game.getPlainTerrainSpeedFactor(); break;
+      }
+      switch (weather[x][y]) {
+        case WeatherType::CLOUD: aerial_speed_factor_by_cell_[cell] = game.getCloudWeatherSpeedFactor(); break;
+        case WeatherType::RAIN: aerial_speed_factor_by_cell_[cell] = game.getRainWeatherSpeedFactor(); break;
+        default: aerial_speed_factor_by_cell_[cell] = game.getClearWeatherSpeedFactor(); break;
+      }
+    }
+  }
+  cells_linear_count_ = std::max(1, cells_linear_count_);
+}
@@ -0,0 +1,87 @@
+#pragma once
+#ifndef _SIMULATION_RULES_H_
+#define _SIMULATION_RULES_H_
+
+#include "Strategy.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Game rules used by ForwardSimulator, gathered once into flat tables:
+// properties of each vehicle type and speed factors of terrain (for ground vehicles)
+// and weather (for aerial ones) for every cell of the terrain/weather map.
+class SimulationRules {
+ public:
+  struct TypeRules {
+    bool is_aerial;
+    float speed;
+    float ground_attack_range;
+    float aerial_attack_range;
+    float ground_damage;
+    float aerial_damage;
+    float ground_defence;
+    float aerial_defence;
+    int attack_cooldown_ticks;
+  };
+
+  SimulationRules(const model::World& world, const model::Game& game);
+
+  const TypeRules& ForType(const model::VehicleType& vehicle_type) const {
+    return type_rules_[static_cast<size_t>(vehicle_type)];
+  }
+
+  // Damage of one attack (zero if the defence is stronger)
+  float Damage(const model::VehicleType& attacker, const model::VehicleType& target) const {
+    return damage_by_types_[static_cast<size_t>(attacker)][static_cast<size_t>(target)];
+  }
+
+  // Cell of the terrain/weather map containing the position
+  std::uint32_t CellOf(const float x, const float y) const {
+    const int x_cell = std::min(cells_linear_count_ - 1, std::max(0, static_cast<int>(x / cell_side_length_)));
+    const int y_cell = std::min(cells_linear_count_ - 1, std::max(0, static_cast<int>(y / cell_side_length_)));
+    return static_cast<std::uint32_t>(x_cell * cells_linear_count_ + y_cell);
+  }
+
+  // Multiplier of a vehicle's speed in the cell
+  float SpeedFactor(const bool is_aerial, const std::uint32_t cell) const {
+    return is_aerial ? aerial_speed_factor_by_cell_[cell] : ground_speed_factor_by_cell_[cell];
+  }
+
+  float WorldSideLength() const { return world_side_length_; }
+  float VehicleRadius() const { return vehicle_radius_; }
+  // Speed of the fastest vehicle type (before terrain and weather factors)
+  float MaxSpeed() const { return max_speed_; }
+  // Largest distance at which a vehicle can affect another one (by an attack or a repair)
+  float MaxInteractionRange() const { return max_interaction_range_; }
+
+  float RepairRange() const { return repair_range_; }
+  float RepairSpeed() const { return repair_speed_; }
+
+  float NuclearStrikeRadius() const { return nuclear_strike_radius_; }
+  float MaxNuclearStrikeDamage() const { return max_nuclear_strike_damage_; }
+  int NuclearStrikeDelay() const { return nuclear_strike_delay_; }
+
+ private:
+  static const size_t kNumberOfVehicleTypes = static_cast<size_t>(model::VehicleType::_COUNT_);
+
+  TypeRules type_rules_[kNumberOfVehicleTypes];
+  float damage_by_types_[kNumberOfVehicleTypes][kNumberOfVehicleTypes];
+
+  float world_side_length_;
+  float vehicle_radius_;
+  float max_speed_;
+  float max_interaction_range_;
+  float repair_range_;
+  float repair_speed_;
+  float nuclear_strike_radius_;
+  float max_nuclear_strike_damage_;
+  int nuclear_strike_delay_;
+
+  // Speed factors by cell of the terrain/weather map, indexed by x * cells_linear_count_ + y
+  int cells_linear_count_;
+  float cell_side_length_;
+  std::vector<float> ground_speed_factor_by_cell_;
+  std::vector<float> aerial_speed_factor_by_cell_;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "SpatialGrid.h"
+
+#include <cmath>
+
+SpatialGrid::SpatialGrid(const VehicleStore& vehicles, const double world_side_length,
+                         const double cell_side_length)
+    : vehicles_(vehicles),
+      cell_side_length_(cell_side_length),
+      cells_linear_count_(std::max(1, static_cast<int>(std::ceil(world_side_length / cell_side_length)))) {
+  ids_by_cell_.resize(static_cast<size_t>(cells_linear_count_) * cells_linear_count_);
+}
+
+void SpatialGrid::Insert(const long long vehicle_id) {
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  const size_t cell = CellIndex(CellCoordinate(vehicles_.X(slot)), CellCoordinate(vehicles_.Y(slot)));
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= cell_by_id_.size()) {
+    cell_by_id_.resize(id_index * 2 + 1, VehicleStore::kNoSlot);
+    position_in_cell_by_id_.resize(id_index * 2 + 1);
+  }
+  if (cell_by_id_[id_index] != VehicleStore::kNoSlot) {
+    // The vehicle is already known (e.g. it has been reported as a new one twice)
+    Move(vehicle_id);
+    return;
+  }
+  cell_by_id_[id_index] = cell;
+  position_in_cell_by_id_[id_index] = ids_by_cell_[cell].size();
+  ids_by_cell_[cell].push_back(vehicle_id);
+}
+
+void SpatialGrid::Move(const long long vehicle_id) {
+  const size_t slot = vehicles_.SlotById(vehicle_id);
+  const size_t cell = CellIndex(CellCoordinate(vehicles_.X(slot)), CellCoordinate(vehicles_.Y(slot)));
+  if (cell_by_id_[static_cast<size_t>(vehicle_id)] != cell) {
+    Remove(vehicle_id);
+    Insert(vehicle_id);
+  }
+}
+
+void SpatialGrid::Remove(const long long vehicle_id) {
+  const size_t id_index = static_cast<size_t>(vehicle_id);
+  if (id_index >= cell_by_id_.size() || cell_by_id_[id_index] == VehicleStore::kNoSlot) {
+    return;
+  }
+  std::vector<long long>& ids = ids_by_cell_[cell_by_id_[id_index]];
+  const size_t position = position_in_cell_by_id_[id_index];
+
+  // Moves the last vehicle of the cell into the freed position
+  ids[position] = ids.back();
+  position_in_cell_by_id_[static_cast<size_t>(ids[position])] = position;
+  ids.pop_back();
+  cell_by_id_[id_index] = VehicleStore::kNoSlot;
+}
+
+int SpatialGrid::CellCoordinate(const double coordinate) const {
+  const int cell = static_cast<int>(std::floor(coordinate / cell_side_length_));
+  return std::min(std::max(cell, 0), cells_linear_count_ - 1);
+}
+
+size_t SpatialGrid::CellIndex(const int x_cell, const int y_cell) const {
+  return static_cast<size_t>(x_cell) * cells_linear_count_ + y_cell;
+}
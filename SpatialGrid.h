@@ -0,0 +1,161 @@
+#pragma once
+#ifndef _SPATIAL_GRID_H_
+#define _SPATIAL_GRID_H_
+
+#include "Vect.h"
+#include "VehicleStore.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Buckets all visible vehicles into square cells of equal size.
+// The grid is persistent: it is patched on every addition, move and removal of a vehicle,
+// so that proximity queries look only at the cells around the point of interest.
+// Queries accept a predicate on a vehicle's slot in VehicleStore (e.g. to filter by owner or type)
+// and report slots as well.
+class SpatialGrid {
+ public:
+  SpatialGrid(const VehicleStore& vehicles, const double world_side_length, const double cell_side_length);
+
+  // Must be called after the corresponding change in VehicleStore (Remove - before it)
+  void Insert(const long long vehicle_id);
+  void Move(const long long vehicle_id);
+  void Remove(const long long vehicle_id);
+
+  // Returns the slot of the closest vehicle satisfying `predicate` (VehicleStore::kNoSlot if there's none)
+  template <typename Predicate>
+  size_t Nearest(const Vect& point, Predicate predicate) const;
+
+  // Fills `result` with up to `k` closest vehicles satisfying `predicate`,
+  // as {squared distance; slot} pairs ordered by distance
+  template <typename Predicate>
+  void KNearest(const Vect& point, const size_t k, Predicate predicate,
+                std::vector<std::pair<double, size_t>>& result) const;
+
+  // Calls `visitor(slot)` for every vehicle strictly closer than `radius` to `point`
+  template <typename Visitor>
+  void ForEachWithinRadius(const Vect& point, const double radius, Visitor visitor) const;
+
+  // Calls `visitor(slot)` for every vehicle from the cells that intersect the square
+  // with center at `point` and side 2 * `radius` (no distance check, so it's a superset of the circle)
+  template <typename Visitor>
+  void ForEachInCellsAround(const Vect& point, const double radius, Visitor visitor) const;
+
+ private:
+  int CellCoordinate(const double coordinate) const;
+  size_t CellIndex(const int x_cell, const int y_cell) const;
+
+  // Visits every cell on the border of a square with center at (`x_cell`; `y_cell`) and "radius" `ring`
+  template <typename CellVisitor>
+  void ForEachCellInRing(const int x_cell, const int y_cell, const int ring, CellVisitor cell_visitor) const;
+
+  const VehicleStore& vehicles_;
+  const double cell_side_length_;
+  const int cells_linear_count_;
+
+  std::vector<std::vector<long long>> ids_by_cell_;
+  std::vector<size_t> cell_by_id_;
+  std::vector<size_t> position_in_cell_by_id_;
+};
+
+template <typename CellVisitor>
+void SpatialGrid::ForEachCellInRing(const int x_cell, const int y_cell, const int ring,
+                                    CellVisitor cell_visitor) const {
+  const int min_x = std::max(0, x_cell - ring);
+  const int max_x = std::min(cells_linear_count_ - 1, x_cell + ring);
+  const int min_y = std::max(0, y_cell - ring);
+  const int max_y = std::min(cells_linear_count_ - 1, y_cell + ring);
+  for (int x = min_x; x <= max_x; x++) {
+    const bool is_vertical_border = x == x_cell - ring || x == x_cell + ring;
+    if (is_vertical_border) {
+      for (int y = min_y; y <= max_y; y++) {
+        cell_visitor(ids_by_cell_[CellIndex(x, y)]);
+      }
+    }
+    else {
+      if (y_cell - ring >= 0) {
+        cell_visitor(ids_by_cell_[CellIndex(x, y_cell - ring)]);
+      }
+      if (ring > 0 && y_cell + ring < cells_linear_count_) {
+        cell_visitor(ids_by_cell_[CellIndex(x, y_cell + ring)]);
+      }
+    }
+  }
+}
+
+template <typename Predicate>
+size_t SpatialGrid::Nearest(const Vect& point, Predicate predicate) const {
+  std::vector<std::pair<double, size_t>> closest;
+  KNearest(point, 1, predicate, closest);
+  return closest.empty() ? VehicleStore::kNoSlot : closest[0].second;
+}
+
+template <typename Predicate>
+void SpatialGrid::KNearest(const Vect& point, const size_t k, Predicate predicate,
+                           std::vector<std::pair<double, size_t>>& result) const {
+  result.clear();
+  if (k == 0) {
+    return;
+  }
+  const int x_cell = CellCoordinate(point.x);
+  const int y_cell = CellCoordinate(point.y);
+
+  // `result` is kept as a max-heap by distance while the search goes on
+  for (int ring = 0; ring < cells_linear_count_; ring++) {
+    ForEachCellInRing(x_cell, y_cell, ring, [&](const std::vector<long long>& ids) {
+      for (const long long id : ids) {
+        const size_t slot = vehicles_.SlotById(id);
+        if (!predicate(slot)) {
+          continue;
+        }
+        const double dx = vehicles_.X(slot) - point.x;
+        const double dy = vehicles_.Y(slot) - point.y;
+        const std::pair<double, size_t> candidate(dx * dx + dy * dy, slot);
+        if (result.size() < k) {
+          result.push_back(candidate);
+          std::push_heap(result.begin(), result.end());
+        }
+        else if (candidate < result.front()) {
+          std::pop_heap(result.begin(), result.end());
+          result.back() = candidate;
+          std::push_heap(result.begin(), result.end());
+        }
+      }
+    });
+    // every cell outside of the visited rings is farther than `ring` cell sides from the point
+    const double unvisited_distance = ring * cell_side_length_;
+    if (result.size() == k && result.front().first <= unvisited_distance * unvisited_distance) {
+      break;
+    }
+  }
+  std::sort_heap(result.begin(), result.end());
+}
+
+template <typename Visitor>
+void SpatialGrid::ForEachWithinRadius(const Vect& point, const double radius, Visitor visitor) const {
+  const double squared_radius = radius * radius;
+  ForEachInCellsAround(point, radius, [&](const size_t slot) {
+    const double dx = vehicles_.X(slot) - point.x;
+    const double dy = vehicles_.Y(slot) - point.y;
+    if (dx * dx + dy * dy < squared_radius) {
+      visitor(slot);
+    }
+  });
+}
+
+template <typename Visitor>
+void SpatialGrid::ForEachInCellsAround(const Vect& point, const double radius, Visitor visitor) const {
+  const int min_x = CellCoordinate(point.x - radius);
+  const int max_x = CellCoordinate(point.x + radius);
+  const int min_y = CellCoordinate(point.y - radius);
+  const int max_y = CellCoordinate(point.y + radius);
+  for (int x = min_x; x <= max_x; x++) {
+    for (int y = min_y; y <= max_y; y++) {
+      for (const long long id : ids_by_cell_[CellIndex(x, y)]) {
+        visitor(vehicles_.SlotById(id));
+      }
+    }
+  }
+}
+
+#endif
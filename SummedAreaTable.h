@@ -0,0 +1,48 @@
+#pragma once
+#ifndef _SUMMED_AREA_TABLE_H_
+#define _SUMMED_AREA_TABLE_H_
+
+#include <cstddef>
+#include <vector>
+
+// 2D prefix sums over a square grid of cells.
+// Values are accumulated cell by cell with Add(), then Build() turns them into prefix sums,
+// after which the total of any axis-aligned block of cells is available in O(1).
+template <typename T>
+class SummedAreaTable {
+ public:
+  // Clears the table and sets its size to `side` x `side` cells
+  void Reset(const size_t side) {
+    side_ = side;
+    prefix_sums_.assign((side + 1) * (side + 1), T());
+  }
+
+  void Add(const size_t x, const size_t y, const T& value) {
+    prefix_sums_[Index(x + 1, y + 1)] += value;
+  }
+
+  void Build() {
+    for (size_t x = 1; x <= side_; x++) {
+      for (size_t y = 1; y <= side_; y++) {
+        prefix_sums_[Index(x, y)] += prefix_sums_[Index(x - 1, y)] + prefix_sums_[Index(x, y - 1)] -
+                                     prefix_sums_[Index(x - 1, y - 1)];
+      }
+    }
+  }
+
+  // Total over the cells [x_begin; x_end) x [y_begin; y_end)
+  T Sum(const size_t x_begin, const size_t y_begin, const size_t x_end, const size_t y_end) const {
+    return prefix_sums_[Index(x_end, y_end)] - prefix_sums_[Index(x_begin, y_end)] -
+           prefix_sums_[Index(x_end, y_begin)] + prefix_sums_[Index(x_begin, y_begin)];
+  }
+
+  size_t Side() const { return side_; }
+
+ private:
+  size_t Index(const size_t x, const size_t y) const { return x * (side_ + 1) + y; }
+
+  size_t side_ = 0;
+  std::vector<T> prefix_sums_;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "TickRecorder.h"
+
+#include "TickRecording.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace model;
+
+TickRecorder::TickRecorder(const std::string& file_name) : file_(std::fopen(file_name.c_str(), "wb")) {}
+
+TickRecorder::~TickRecorder() {
+  if (file_) {
+    std::fclose(file_);
+  }
+}
+
+void TickRecorder::RecordTick(const Player& me, const World& world, const Game& game) {
+  if (!file_) {
+    return;
+  }
+  if (!is_header_recorded_) {
+    RecordHeader(me, world, game);
+    is_header_recorded_ = true;
+  }
+
+  RecordedTickHeader tick_header = {};
+  tick_header.tick_index = world.getTickIndex();
+  tick_header.tick_count = world.getTickCount();
+  tick_header.width = world.getWidth();
+  tick_header.height = world.getHeight();
+  tick_header.players_count = static_cast<std::uint32_t>(world.getPlayers().size());
+  tick_header.new_vehicles_count = static_cast<std::uint32_t>(world.getNewVehicles().size());
+  tick_header.vehicle_updates_count = static_cast<std::uint32_t>(world.getVehicleUpdates().size());
+  tick_header.facilities_count = static_cast<std::uint32_t>(world.getFacilities().size());
+  Write(tick_header);
+
+  for (const Player& player : world.getPlayers()) {
+    Write(RecordedPlayer::From(player));
+  }
+  for (const Vehicle& vehicle : world.getNewVehicles()) {
+    Write(RecordedVehicle::From(vehicle));
+  }
+  for (const VehicleUpdate& vehicle_update : world.getVehicleUpdates()) {
+    Write(RecordedVehicleUpdate::From(vehicle_update));
+  }
+  for (const Facility& facility : world.getFacilities()) {
+    Write(RecordedFacility::From(facility));
+  }
+}
+
+void TickRecorder::RecordHeader(const Player& me, const World& world, const Game& game) {
+  const auto& terrain = world.getTerrainByCellXY();
+  const auto& weather = world.getWeatherByCellXY();
+
+  RecordingHeader header = {};
+  std::memcpy(header.magic, kRecordingMagic, sizeof(header.magic));
+  header.version = kRecordingVersion;
+  header.my_player_id = me.getId();
+  header.game = RecordedGame::From(game);
+  header.terrain_weather_columns = static_cast<std::int32_t>(terrain.size());
+  header.terrain_weather_rows = terrain.empty() ? 0 : static_cast<std::int32_t>(terrain[0].size());
+  Write(header);
+
+  // Both maps have the same size
+  std::vector<std::int8_t> cells;
+  for (const auto& column : terrain) {
+    for (const TerrainType& cell : column) {
+      cells.push_back(static_cast<std::int8_t>(cell));
+    }
+  }
+  for (const auto& column : weather) {
+    for (const WeatherType& cell : column) {
+      cells.push_back(static_cast<std::int8_t>(cell));
+    }
+  }
+  std::fwrite(cells.data(), sizeof(std::int8_t), cells.size(), file_);
+}
+
+template <typename Record>
+void TickRecorder::Write(const Record& record) {
+  std::fwrite(&record, sizeof(Record), 1, file_);
+}
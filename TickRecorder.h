@@ -0,0 +1,33 @@
+#pragma once
+#ifndef _TICK_RECORDER_H_
+#define _TICK_RECORDER_H_
+
+#include "Strategy.h"
+#include <cstdio>
+#include <string>
+
+// Writes everything the strategy receives on each tick into a binary file (format: see TickRecording.h),
+// so that the game can be replayed offline with replay/Replay.cpp.
+// MyStrategy records games only if it's compiled with MY_STRATEGY_RECORDING defined.
+class TickRecorder {
+ public:
+  explicit TickRecorder(const std::string& file_name);
+  ~TickRecorder();
+
+  TickRecorder(const TickRecorder&) = delete;
+  TickRecorder& operator=(const TickRecorder&) = delete;
+
+  // Game constants, terrain and weather are written along with the first recorded tick
+  void RecordTick(const model::Player& me, const model::World& world, const model::Game& game);
+
+ private:
+  void RecordHeader(const model::Player& me, const model::World& world, const model::Game& game);
+
+  template <typename Record>
+  void Write(const Record& record);
+
+  std::FILE* file_;
+  bool is_header_recorded_ = false;
+};
+
+#endif
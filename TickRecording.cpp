@@ -0,0 +1,107 @@
+#include "TickRecording.h"
+
+using namespace model;
+
+RecordedGame RecordedGame::From(const Game& game) {
+  RecordedGame recorded = {};
+  recorded.random_seed = game.getRandomSeed();
+#define RECORD_GAME_FIELD(type, member, getter) recorded.member = game.getter();
+  RECORDED_GAME_FIELDS(RECORD_GAME_FIELD)
+#undef RECORD_GAME_FIELD
+  return recorded;
+}
+
+Game RecordedGame::ToModel() const {
+#define PASS_GAME_FIELD(type, member, getter) , member
+  return Game(random_seed RECORDED_GAME_FIELDS(PASS_GAME_FIELD));
+#undef PASS_GAME_FIELD
+}
+
+RecordedPlayer RecordedPlayer::From(const Player& player) {
+  RecordedPlayer recorded = {};
+  recorded.id = player.getId();
+  recorded.next_nuclear_strike_vehicle_id = player.getNextNuclearStrikeVehicleId();
+  recorded.next_nuclear_strike_x = player.getNextNuclearStrikeX();
+  recorded.next_nuclear_strike_y = player.getNextNuclearStrikeY();
+  recorded.score = player.getScore();
+  recorded.remaining_action_cooldown_ticks = player.getRemainingActionCooldownTicks();
+  recorded.remaining_nuclear_strike_cooldown_ticks = player.getRemainingNuclearStrikeCooldownTicks();
+  recorded.next_nuclear_strike_tick_index = player.getNextNuclearStrikeTickIndex();
+  recorded.me = player.isMe();
+  recorded.strategy_crashed = player.isStrategyCrashed();
+  return recorded;
+}
+
+Player RecordedPlayer::ToModel() const {
+  return Player(id, me, strategy_crashed, score, remaining_action_cooldown_ticks,
+                remaining_nuclear_strike_cooldown_ticks, next_nuclear_strike_vehicle_id,
+                next_nuclear_strike_tick_index, next_nuclear_strike_x, next_nuclear_strike_y);
+}
+
+RecordedVehicle RecordedVehicle::From(const Vehicle& vehicle) {
+  RecordedVehicle recorded = {};
+  recorded.id = vehicle.getId();
+  recorded.player_id = vehicle.getPlayerId();
+  recorded.x = vehicle.getX();
+  recorded.y = vehicle.getY();
+  recorded.radius = vehicle.getRadius();
+  recorded.max_speed = vehicle.getMaxSpeed();
+  recorded.vision_range = vehicle.getVisionRange();
+  recorded.ground_attack_range = vehicle.getGroundAttackRange();
+  recorded.aerial_attack_range = vehicle.getAerialAttackRange();
+  recorded.durability = vehicle.getDurability();
+  recorded.max_durability = vehicle.getMaxDurability();
+  recorded.ground_damage = vehicle.getGroundDamage();
+  recorded.aerial_damage = vehicle.getAerialDamage();
+  recorded.ground_defence = vehicle.getGroundDefence();
+  recorded.aerial_defence = vehicle.getAerialDefence();
+  recorded.attack_cooldown_ticks = vehicle.getAttackCooldownTicks();
+  recorded.remaining_attack_cooldown_ticks = vehicle.getRemainingAttackCooldownTicks();
+  recorded.type = static_cast<std::int8_t>(vehicle.getType());
+  recorded.aerial = vehicle.isAerial();
+  recorded.selected = vehicle.isSelected();
+  return recorded;
+}
+
+Vehicle RecordedVehicle::ToModel() const {
+  return Vehicle(id, x, y, radius, player_id, durability, max_durability, max_speed,
+                 vision_range, vision_range * vision_range,
+                 ground_attack_range, ground_attack_range * ground_attack_range,
+                 aerial_attack_range, aerial_attack_range * aerial_attack_range,
+                 ground_damage, aerial_damage, ground_defence, aerial_defence,
+                 attack_cooldown_ticks, remaining_attack_cooldown_ticks,
+                 static_cast<VehicleType>(type), aerial, selected, std::vector<int>());
+}
+
+RecordedVehicleUpdate RecordedVehicleUpdate::From(const VehicleUpdate& vehicle_update) {
+  RecordedVehicleUpdate recorded = {};
+  recorded.id = vehicle_update.getId();
+  recorded.x = vehicle_update.getX();
+  recorded.y = vehicle_update.getY();
+  recorded.durability = vehicle_update.getDurability();
+  recorded.remaining_attack_cooldown_ticks = vehicle_update.getRemainingAttackCooldownTicks();
+  recorded.selected = vehicle_update.isSelected();
+  return recorded;
+}
+
+VehicleUpdate RecordedVehicleUpdate::ToModel() const {
+  return VehicleUpdate(id, x, y, durability, remaining_attack_cooldown_ticks, selected, std::vector<int>());
+}
+
+RecordedFacility RecordedFacility::From(const Facility& facility) {
+  RecordedFacility recorded = {};
+  recorded.id = facility.getId();
+  recorded.owner_player_id = facility.getOwnerPlayerId();
+  recorded.left = facility.getLeft();
+  recorded.top = facility.getTop();
+  recorded.capture_points = facility.getCapturePoints();
+  recorded.production_progress = facility.getProductionProgress();
+  recorded.type = static_cast<std::int8_t>(facility.getType());
+  recorded.vehicle_type = static_cast<std::int8_t>(facility.getVehicleType());
+  return recorded;
+}
+
+Facility RecordedFacility::ToModel() const {
+  return Facility(id, static_cast<FacilityType>(type), owner_player_id, left, top, capture_points,
+                  static_cast<VehicleType>(vehicle_type), production_progress);
+}
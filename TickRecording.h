@@ -0,0 +1,224 @@
+#pragma once
+#ifndef _TICK_RECORDING_H_
+#define _TICK_RECORDING_H_
+
+#include "Strategy.h"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Binary layout of a recorded game (see TickRecorder).
+// All records are plain structs written as is, so a recording can be read back on the same platform.
+// Records are not aligned in the file (the maps have any length), so a reader copies each one out. The file consists of:
+// - RecordingHeader,
+// - terrain and weather maps (one byte per cell, column-major: [x][y]),
+// - for each tick: RecordedTickHeader followed by its players, new vehicles, vehicle updates and facilities.
+
+const char kRecordingMagic[8] = { 'M', 'Y', 'S', 'T', 'R', 'T', 'C', 'K' };
+const std::uint32_t kRecordingVersion = 1;
+
+// Every constant of model::Game except the random seed, in the order of model::Game constructor arguments.
+// FIELD(type, member, getter)
+#define RECORDED_GAME_FIELDS(FIELD) \
+  FIELD(std::int32_t, tick_count, getTickCount) \
+  FIELD(double, world_width, getWorldWidth) \
+  FIELD(double, world_height, getWorldHeight) \
+  FIELD(bool, fog_of_war_enabled, isFogOfWarEnabled) \
+  FIELD(std::int32_t, victory_score, getVictoryScore) \
+  FIELD(std::int32_t, facility_capture_score, getFacilityCaptureScore) \
+  FIELD(std::int32_t, vehicle_elimination_score, getVehicleEliminationScore) \
+  FIELD(std::int32_t, action_detection_interval, getActionDetectionInterval) \
+  FIELD(std::int32_t, base_action_count, getBaseActionCount) \
+  FIELD(std::int32_t, additional_action_count_per_control_center, getAdditionalActionCountPerControlCenter) \
+  FIELD(std::int32_t, max_unit_group, getMaxUnitGroup) \
+  FIELD(std::int32_t, terrain_weather_map_column_count, getTerrainWeatherMapColumnCount) \
+  FIELD(std::int32_t, terrain_weather_map_row_count, getTerrainWeatherMapRowCount) \
+  FIELD(double, plain_terrain_vision_factor, getPlainTerrainVisionFactor) \
+  FIELD(double, plain_terrain_stealth_factor, getPlainTerrainStealthFactor) \
+  FIELD(double, plain_terrain_speed_factor, getPlainTerrainSpeedFactor) \
+  FIELD(double, swamp_terrain_vision_factor, getSwampTerrainVisionFactor) \
+  FIELD(double, swamp_terrain_stealth_factor, getSwampTerrainStealthFactor) \
+  FIELD(double, swamp_terrain_speed_factor, getSwampTerrainSpeedFactor) \
+  FIELD(double, forest_terrain_vision_factor, getForestTerrainVisionFactor) \
+  FIELD(double, forest_terrain_stealth_factor, getForestTerrainStealthFactor) \
+  FIELD(double, forest_terrain_speed_factor, getForestTerrainSpeedFactor) \
+  FIELD(double, clear_weather_vision_factor, getClearWeatherVisionFactor) \
+  FIELD(double, clear_weather_stealth_factor, getClearWeatherStealthFactor) \
+  FIELD(double, clear_weather_speed_factor, getClearWeatherSpeedFactor) \
+  FIELD(double, cloud_weather_vision_factor, getCloudWeatherVisionFactor) \
+  FIELD(double, cloud_weather_stealth_factor, getCloudWeatherStealthFactor) \
+  FIELD(double, cloud_weather_speed_factor, getCloudWeatherSpeedFactor) \
+  FIELD(double, rain_weather_vision_factor, getRainWeatherVisionFactor) \
+  FIELD(double, rain_weather_stealth_factor, getRainWeatherStealthFactor) \
+  FIELD(double, rain_weather_speed_factor, getRainWeatherSpeedFactor) \
+  FIELD(double, vehicle_radius, getVehicleRadius) \
+  FIELD(std::int32_t, tank_durability, getTankDurability) \
+  FIELD(double, tank_speed, getTankSpeed) \
+  FIELD(double, tank_vision_range, getTankVisionRange) \
+  FIELD(double, tank_ground_attack_range, getTankGroundAttackRange) \
+  FIELD(double, tank_aerial_attack_range, getTankAerialAttackRange) \
+  FIELD(std::int32_t, tank_ground_damage, getTankGroundDamage) \
+  FIELD(std::int32_t, tank_aerial_damage, getTankAerialDamage) \
+  FIELD(std::int32_t, tank_ground_defence, getTankGroundDefence) \
+  FIELD(std::int32_t, tank_aerial_defence, getTankAerialDefence) \
+  FIELD(std::int32_t, tank_attack_cooldown_ticks, getTankAttackCooldownTicks) \
+  FIELD(std::int32_t, tank_production_cost, getTankProductionCost) \
+  FIELD(std::int32_t, ifv_durability, getIfvDurability) \
+  FIELD(double, ifv_speed, getIfvSpeed) \
+  FIELD(double, ifv_vision_range, getIfvVisionRange) \
+  FIELD(double, ifv_ground_attack_range, getIfvGroundAttackRange) \
+  FIELD(double, ifv_aerial_attack_range, getIfvAerialAttackRange) \
+  FIELD(std::int32_t, ifv_ground_damage, getIfvGroundDamage) \
+  FIELD(std::int32_t, ifv_aerial_damage, getIfvAerialDamage) \
+  FIELD(std::int32_t, ifv_ground_defence, getIfvGroundDefence) \
+  FIELD(std::int32_t, ifv_aerial_defence, getIfvAerialDefence) \
+  FIELD(std::int32_t, ifv_attack_cooldown_ticks, getIfvAttackCooldownTicks) \
+  FIELD(std::int32_t, ifv_production_cost, getIfvProductionCost) \
+  FIELD(std::int32_t, arrv_durability, getArrvDurability) \
+  FIELD(double, arrv_speed, getArrvSpeed) \
+  FIELD(double, arrv_vision_range, getArrvVisionRange) \
+  FIELD(std::int32_t, arrv_ground_defence, getArrvGroundDefence) \
+  FIELD(std::int32_t, arrv_aerial_defence, getArrvAerialDefence) \
+  FIELD(std::int32_t, arrv_production_cost, getArrvProductionCost) \
+  FIELD(double, arrv_repair_range, getArrvRepairRange) \
+  FIELD(double, arrv_repair_speed, getArrvRepairSpeed) \
+  FIELD(std::int32_t, helicopter_durability, getHelicopterDurability) \
+  FIELD(double, helicopter_speed, getHelicopterSpeed) \
+  FIELD(double, helicopter_vision_range, getHelicopterVisionRange) \
+  FIELD(double, helicopter_ground_attack_range, getHelicopterGroundAttackRange) \
+  FIELD(double, helicopter_aerial_attack_range, getHelicopterAerialAttackRange) \
+  FIELD(std::int32_t, helicopter_ground_damage, getHelicopterGroundDamage) \
+  FIELD(std::int32_t, helicopter_aerial_damage, getHelicopterAerialDamage) \
+  FIELD(std::int32_t, helicopter_ground_defence, getHelicopterGroundDefence) \
+  FIELD(std::int32_t, helicopter_aerial_defence, getHelicopterAerialDefence) \
+  FIELD(std::int32_t, helicopter_attack_cooldown_ticks, getHelicopterAttackCooldownTicks) \
+  FIELD(std::int32_t, helicopter_production_cost, getHelicopterProductionCost) \
+  FIELD(std::int32_t, fighter_durability, getFighterDurability) \
+  FIELD(double, fighter_speed, getFighterSpeed) \
+  FIELD(double, fighter_vision_range, getFighterVisionRange) \
+  FIELD(double, fighter_ground_attack_range, getFighterGroundAttackRange) \
+  FIELD(double, fighter_aerial_attack_range, getFighterAerialAttackRange) \
+  FIELD(std::int32_t, fighter_ground_damage, getFighterGroundDamage) \
+  FIELD(std::int32_t, fighter_aerial_damage, getFighterAerialDamage) \
+  FIELD(std::int32_t, fighter_ground_defence, getFighterGroundDefence) \
+  FIELD(std::int32_t, fighter_aerial_defence, getFighterAerialDefence) \
+  FIELD(std::int32_t, fighter_attack_cooldown_ticks, getFighterAttackCooldownTicks) \
+  FIELD(std::int32_t, fighter_production_cost, getFighterProductionCost) \
+  FIELD(double, max_facility_capture_points, getMaxFacilityCapturePoints) \
+  FIELD(double, facility_capture_points_per_vehicle_per_tick, getFacilityCapturePointsPerVehiclePerTick) \
+  FIELD(double, facility_width, getFacilityWidth) \
+  FIELD(double, facility_height, getFacilityHeight) \
+  FIELD(std::int32_t, base_tactical_nuclear_strike_cooldown, getBaseTacticalNuclearStrikeCooldown) \
+  FIELD(std::int32_t, tactical_nuclear_strike_cooldown_decrease_per_control_center, \
+        getTacticalNuclearStrikeCooldownDecreasePerControlCenter) \
+  FIELD(double, max_tactical_nuclear_strike_damage, getMaxTacticalNuclearStrikeDamage) \
+  FIELD(double, tactical_nuclear_strike_radius, getTacticalNuclearStrikeRadius) \
+  FIELD(std::int32_t, tactical_nuclear_strike_delay, getTacticalNuclearStrikeDelay)
+
+struct RecordedGame {
+  std::int64_t random_seed;
+#define DECLARE_RECORDED_GAME_FIELD(type, member, getter) type member;
+  RECORDED_GAME_FIELDS(DECLARE_RECORDED_GAME_FIELD)
+#undef DECLARE_RECORDED_GAME_FIELD
+
+  static RecordedGame From(const model::Game& game);
+  model::Game ToModel() const;
+};
+
+struct RecordingHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::int64_t my_player_id;
+  RecordedGame game;
+  std::int32_t terrain_weather_columns;
+  std::int32_t terrain_weather_rows;
+};
+
+struct RecordedTickHeader {
+  std::int32_t tick_index;
+  std::int32_t tick_count;
+  double width;
+  double height;
+  std::uint32_t players_count;
+  std::uint32_t new_vehicles_count;
+  std::uint32_t vehicle_updates_count;
+  std::uint32_t facilities_count;
+};
+
+struct RecordedPlayer {
+  std::int64_t id;
+  std::int64_t next_nuclear_strike_vehicle_id;
+  double next_nuclear_strike_x;
+  double next_nuclear_strike_y;
+  std::int32_t score;
+  std::int32_t remaining_action_cooldown_ticks;
+  std::int32_t remaining_nuclear_strike_cooldown_ticks;
+  std::int32_t next_nuclear_strike_tick_index;
+  bool me;
+  bool strategy_crashed;
+
+  static RecordedPlayer From(const model::Player& player);
+  model::Player ToModel() const;
+};
+
+// Vehicle groups are not recorded: the strategy doesn't use them
+struct RecordedVehicle {
+  std::int64_t id;
+  std::int64_t player_id;
+  double x;
+  double y;
+  double radius;
+  double max_speed;
+  double vision_range;
+  double ground_attack_range;
+  double aerial_attack_range;
+  std::int32_t durability;
+  std::int32_t max_durability;
+  std::int32_t ground_damage;
+  std::int32_t aerial_damage;
+  std::int32_t ground_defence;
+  std::int32_t aerial_defence;
+  std::int32_t attack_cooldown_ticks;
+  std::int32_t remaining_attack_cooldown_ticks;
+  std::int8_t type;
+  bool aerial;
+  bool selected;
+
+  static RecordedVehicle From(const model::Vehicle& vehicle);
+  model::Vehicle ToModel() const;
+};
+
+struct RecordedVehicleUpdate {
+  std::int64_t id;
+  double x;
+  double y;
+  std::int32_t durability;
+  std::int32_t remaining_attack_cooldown_ticks;
+  bool selected;
+
+  static RecordedVehicleUpdate From(const model::VehicleUpdate& vehicle_update);
+  model::VehicleUpdate ToModel() const;
+};
+
+struct RecordedFacility {
+  std::int64_t id;
+  std::int64_t owner_player_id;
+  double left;
+  double top;
+  double capture_points;
+  std::int32_t production_progress;
+  std::int8_t type;
+  std::int8_t vehicle_type;
+
+  static RecordedFacility From(const model::Facility& facility);
+  model::Facility ToModel() const;
+};
+
+static_assert(std::is_trivially_copyable<RecordingHeader>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<RecordedTickHeader>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<RecordedPlayer>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<RecordedVehicle>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<RecordedVehicleUpdate>::value, "records must be trivially copyable");
+static_assert(std::is_trivially_copyable<RecordedFacility>::value, "records must be trivially copyable");
+
+#endif
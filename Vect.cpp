@@ -35,6 +35,10 @@ Vect operator * (const Vect& v, const double multiplier) {
   return Vect(v.x * multiplier, v.y * multiplier);
 }
 
+bool operator == (const Vect& a, const Vect& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
 Vect& Vect::operator *= (const double multiplier) {
   *this = *this * multiplier;
   return *this;
@@ -49,3 +53,7 @@ void Vect::Normalize() {
   x /= len;
   y /= len;
 }
+
+Vect Vect::Rotated(const double angle) const {
+  return Vect(x * cos(angle) - y * sin(angle), x * sin(angle) + y * cos(angle));
+}
@@ -18,6 +18,7 @@ class Vect {
   friend Vect operator - (const Vect& a, const Vect& b);
   friend Vect operator / (const Vect& v, const double divisor);
   friend Vect operator * (const Vect& v, const double multiplier);
+  friend bool operator == (const Vect& a, const Vect& b);
 
   Vect& operator += (const Vect& summand);
   Vect& operator /= (const double divisor);
@@ -25,6 +26,8 @@ class Vect {
 
   double Length() const;
   void Normalize();
+  // The vector turned by <angle> radians (in the same direction as Rotate turns vehicles)
+  Vect Rotated(const double angle) const;
 };
 
 const Vect kUnitVector = Vect(1, 1);
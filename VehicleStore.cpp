@@ -0,0 +1,231 @@
+#include "VehicleStore.h"
+
+#include <algorithm>
+#include <limits>
+
+const size_t VehicleStore::kNoSlot = std::numeric_limits<size_t>::max();
+const size_t VehicleStore::kPositionHistoryLength;
+
+void VehicleStore::Add(const model::Vehicle& vehicle, const int current_tick) {
+  const long long vehicle_id = vehicle.getId();
+  if (static_cast<size_t>(vehicle_id) >= slot_by_id_.size()) {
+    // IDs are issued sequentially by the game, so the index grows along with the army
+    slot_by_id_.resize(static_cast<size_t>(vehicle_id) * 2 + 1, kNoSlot);
+  }
+
+  size_t slot = slot_by_id_[static_cast<size_t>(vehicle_id)];
+  if (slot != kNoSlot) {
+    AccountInTotals(slot, -1);
+  }
+  else {
+    slot = ids_.size();
+    slot_by_id_[static_cast<size_t>(vehicle_id)] = slot;
+    ids_.push_back(vehicle_id);
+    xs_.push_back(0);
+    ys_.push_back(0);
+    durabilities_.push_back(0);
+    max_durabilities_.push_back(0);
+    vision_ranges_.push_back(0);
+    types_.push_back(vehicle.getType());
+    player_ids_.push_back(0);
+    move_ticks_.push_back(0);
+    update_ticks_.push_back(0);
+    is_selected_.push_back(0);
+    history_ticks_.resize(history_ticks_.size() + kPositionHistoryLength);
+    history_xs_.resize(history_xs_.size() + kPositionHistoryLength);
+    history_ys_.resize(history_ys_.size() + kPositionHistoryLength);
+    history_newest_.push_back(0);
+    history_sizes_.push_back(0);
+  }
+
+  xs_[slot] = vehicle.getX();
+  ys_[slot] = vehicle.getY();
+  durabilities_[slot] = vehicle.getDurability();
+  max_durabilities_[slot] = vehicle.getMaxDurability();
+  vision_ranges_[slot] = vehicle.getVisionRange();
+  types_[slot] = vehicle.getType();
+  player_ids_[slot] = vehicle.getPlayerId();
+  move_ticks_[slot] = current_tick;
+  update_ticks_[slot] = current_tick;
+  is_selected_[slot] = vehicle.isSelected();
+  AccountInTotals(slot, 1);
+  changes_count_++;
+  // a vehicle seen again may have been anywhere meanwhile
+  history_sizes_[slot] = 0;
+  RecordPosition(slot, current_tick);
+}
+
+bool VehicleStore::Update(const model::VehicleUpdate& vehicle_update, const int current_tick,
+                          const double min_shift) {
+  const size_t slot = SlotById(vehicle_update.getId());
+  if (slot == kNoSlot) {
+    return false;
+  }
+
+  if (durabilities_[slot] != vehicle_update.getDurability()) {
+    durabilities_[slot] = vehicle_update.getDurability();
+    changes_count_++;
+  }
+  update_ticks_[slot] = current_tick;
+  if (is_selected_[slot] != vehicle_update.isSelected()) {
+    is_selected_[slot] = vehicle_update.isSelected();
+    TotalsForPlayer(player_ids_[slot]).selected_count[static_cast<size_t>(types_[slot])] +=
+      vehicle_update.isSelected() ? 1 : -1;
+  }
+
+  const double dx = vehicle_update.getX() - xs_[slot];
+  const double dy = vehicle_update.getY() - ys_[slot];
+  if (dx * dx + dy * dy > min_shift * min_shift) {
+    TypeTotals& totals = TotalsForPlayer(player_ids_[slot]);
+    const size_t type_index = static_cast<size_t>(types_[slot]);
+    totals.sum_x[type_index] += dx;
+    totals.sum_y[type_index] += dy;
+
+    xs_[slot] = vehicle_update.getX();
+    ys_[slot] = vehicle_update.getY();
+    move_ticks_[slot] = current_tick;
+    RecordPosition(slot, current_tick);
+    changes_count_++;
+    return true;
+  }
+  return false;
+}
+
+void VehicleStore::Remove(const long long vehicle_id) {
+  const size_t slot = SlotById(vehicle_id);
+  if (slot == kNoSlot) {
+    return;
+  }
+  AccountInTotals(slot, -1);
+  changes_count_++;
+
+  // Moves the last vehicle into the freed slot
+  const size_t last = ids_.size() - 1;
+  if (slot != last) {
+    ids_[slot] = ids_[last];
+    xs_[slot] = xs_[last];
+    ys_[slot] = ys_[last];
+    durabilities_[slot] = durabilities_[last];
+    max_durabilities_[slot] = max_durabilities_[last];
+    vision_ranges_[slot] = vision_ranges_[last];
+    types_[slot] = types_[last];
+    player_ids_[slot] = player_ids_[last];
+    move_ticks_[slot] = move_ticks_[last];
+    update_ticks_[slot] = update_ticks_[last];
+    is_selected_[slot] = is_selected_[last];
+    std::copy_n(history_ticks_.begin() + last * kPositionHistoryLength, kPositionHistoryLength,
+                history_ticks_.begin() + slot * kPositionHistoryLength);
+    std::copy_n(history_xs_.begin() + last * kPositionHistoryLength, kPositionHistoryLength,
+                history_xs_.begin() + slot * kPositionHistoryLength);
+    std::copy_n(history_ys_.begin() + last * kPositionHistoryLength, kPositionHistoryLength,
+                history_ys_.begin() + slot * kPositionHistoryLength);
+    history_newest_[slot] = history_newest_[last];
+    history_sizes_[slot] = history_sizes_[last];
+    slot_by_id_[static_cast<size_t>(ids_[slot])] = slot;
+  }
+  slot_by_id_[static_cast<size_t>(vehicle_id)] = kNoSlot;
+
+  ids_.pop_back();
+  xs_.pop_back();
+  ys_.pop_back();
+  durabilities_.pop_back();
+  max_durabilities_.pop_back();
+  vision_ranges_.pop_back();
+  types_.pop_back();
+  player_ids_.pop_back();
+  move_ticks_.pop_back();
+  update_ticks_.pop_back();
+  is_selected_.pop_back();
+  history_ticks_.resize(history_ticks_.size() - kPositionHistoryLength);
+  history_xs_.resize(history_xs_.size() - kPositionHistoryLength);
+  history_ys_.resize(history_ys_.size() - kPositionHistoryLength);
+  history_newest_.pop_back();
+  history_sizes_.pop_back();
+}
+
+Vect VehicleStore::Velocity(const size_t slot, const int current_tick) const {
+  const size_t ring = slot * kPositionHistoryLength;
+  const size_t newest = ring + history_newest_[slot];
+  if (history_sizes_[slot] < 2 || current_tick - history_ticks_[newest] > 1) {
+    return Vect();
+  }
+  // walks back while the vehicle was moving on every tick
+  size_t oldest = newest;
+  for (size_t age = 1; age < history_sizes_[slot]; age++) {
+    const size_t previous = ring + (history_newest_[slot] + kPositionHistoryLength - age) % kPositionHistoryLength;
+    if (history_ticks_[oldest] - history_ticks_[previous] > 1) {
+      break;
+    }
+    oldest = previous;
+  }
+  if (oldest == newest) {
+    return Vect();
+  }
+  return Vect(history_xs_[newest] - history_xs_[oldest], history_ys_[newest] - history_ys_[oldest]) /
+         (history_ticks_[newest] - history_ticks_[oldest]);
+}
+
+int VehicleStore::CountByType(const long long player_id, const model::VehicleType& vehicle_type) const {
+  const TypeTotals* totals = FindTotalsForPlayer(player_id);
+  return totals != nullptr ? totals->count[static_cast<size_t>(vehicle_type)] : 0;
+}
+
+Vect VehicleStore::PositionSumByType(const long long player_id, const model::VehicleType& vehicle_type) const {
+  const TypeTotals* totals = FindTotalsForPlayer(player_id);
+  if (totals == nullptr) {
+    return Vect();
+  }
+  const size_t type_index = static_cast<size_t>(vehicle_type);
+  return Vect(totals->sum_x[type_index], totals->sum_y[type_index]);
+}
+
+int VehicleStore::SelectedCountByType(const long long player_id, const model::VehicleType& vehicle_type) const {
+  const TypeTotals* totals = FindTotalsForPlayer(player_id);
+  return totals != nullptr ? totals->selected_count[static_cast<size_t>(vehicle_type)] : 0;
+}
+
+void VehicleStore::AccountInTotals(const size_t slot, const int sign) {
+  TypeTotals& totals = TotalsForPlayer(player_ids_[slot]);
+  const size_t type_index = static_cast<size_t>(types_[slot]);
+  totals.count[type_index] += sign;
+  totals.sum_x[type_index] += sign * xs_[slot];
+  totals.sum_y[type_index] += sign * ys_[slot];
+  totals.selected_count[type_index] += sign * is_selected_[slot];
+  if (totals.count[type_index] == 0) {
+    // drops accumulated rounding errors whenever the group becomes empty
+    totals.sum_x[type_index] = 0;
+    totals.sum_y[type_index] = 0;
+  }
+}
+
+void VehicleStore::RecordPosition(const size_t slot, const int current_tick) {
+  const size_t next = history_sizes_[slot] == 0 ? 0 : (history_newest_[slot] + 1) % kPositionHistoryLength;
+  const size_t record = slot * kPositionHistoryLength + next;
+  history_ticks_[record] = current_tick;
+  history_xs_[record] = xs_[slot];
+  history_ys_[record] = ys_[slot];
+  history_newest_[slot] = static_cast<unsigned char>(next);
+  if (history_sizes_[slot] < kPositionHistoryLength) {
+    history_sizes_[slot]++;
+  }
+}
+
+VehicleStore::TypeTotals& VehicleStore::TotalsForPlayer(const long long player_id) {
+  for (size_t i = 0; i < totals_player_ids_.size(); i++) {
+    if (totals_player_ids_[i] == player_id) {
+      return totals_by_player_[i];
+    }
+  }
+  totals_player_ids_.push_back(player_id);
+  totals_by_player_.emplace_back();
+  return totals_by_player_.back();
+}
+
+const VehicleStore::TypeTotals* VehicleStore::FindTotalsForPlayer(const long long player_id) const {
+  for (size_t i = 0; i < totals_player_ids_.size(); i++) {
+    if (totals_player_ids_[i] == player_id) {
+      return &totals_by_player_[i];
+    }
+  }
+  return nullptr;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#ifndef _VEHICLE_STORE_H_
+#define _VEHICLE_STORE_H_
+
+#include "Strategy.h"
+#include "Vect.h"
+#include <vector>
+
+// Dense storage for the states of all visible vehicles.
+// Every property lives in its own contiguous array (struct of arrays),
+// so that scans over the whole world read only the properties they need.
+// Vehicle ID is a stable handle: it is mapped onto a slot in O(1),
+// and slots are kept compact by moving the last vehicle into the slot of a destroyed one.
+// The last few recorded positions of each vehicle are kept in a ring of fixed size, all rings in a single array,
+// so that velocities can be estimated without allocations.
+class VehicleStore {
+ public:
+  static const size_t kNoSlot;
+  // Number of positions remembered for each vehicle
+  static const size_t kPositionHistoryLength = 8;
+
+  // Saves a vehicle that has just become visible
+  void Add(const model::Vehicle& vehicle, const int current_tick);
+
+  // Applies health/position update to a known vehicle.
+  // Returns true if the vehicle moved by more than `min_shift` since its previous recorded move.
+  bool Update(const model::VehicleUpdate& vehicle_update, const int current_tick, const double min_shift);
+
+  // Forgets a destroyed vehicle (swap-remove)
+  void Remove(const long long vehicle_id);
+
+  size_t Size() const { return ids_.size(); }
+  bool Contains(const long long vehicle_id) const { return SlotById(vehicle_id) != kNoSlot; }
+  size_t SlotById(const long long vehicle_id) const {
+    return vehicle_id >= 0 && static_cast<size_t>(vehicle_id) < slot_by_id_.size() ?
+           slot_by_id_[static_cast<size_t>(vehicle_id)] : kNoSlot;
+  }
+
+  // Per-slot properties
+  long long Id(const size_t slot) const { return ids_[slot]; }
+  double X(const size_t slot) const { return xs_[slot]; }
+  double Y(const size_t slot) const { return ys_[slot]; }
+  Vect Position(const size_t slot) const { return Vect(xs_[slot], ys_[slot]); }
+  int Durability(const size_t slot) const { return durabilities_[slot]; }
+  int MaxDurability(const size_t slot) const { return max_durabilities_[slot]; }
+  double VisionRange(const size_t slot) const { return vision_ranges_[slot]; }
+  model::VehicleType Type(const size_t slot) const { return types_[slot]; }
+  long long PlayerId(const size_t slot) const { return player_ids_[slot]; }
+  int MoveTick(const size_t slot) const { return move_ticks_[slot]; }         // position updated
+  int UpdateTick(const size_t slot) const { return update_ticks_[slot]; }     // anything (health/position) updated
+  bool IsSelected(const size_t slot) const { return is_selected_[slot] != 0; }
+
+  // Velocity (per tick) over the latest continuous movement recorded in the position history;
+  // zero if the vehicle hasn't moved on the current or the previous tick
+  Vect Velocity(const size_t slot, const int current_tick) const;
+
+  // Running totals for each (owner, type) pair, kept up to date on every addition, move and removal
+  int CountByType(const long long player_id, const model::VehicleType& vehicle_type) const;
+  Vect PositionSumByType(const long long player_id, const model::VehicleType& vehicle_type) const;
+  int SelectedCountByType(const long long player_id, const model::VehicleType& vehicle_type) const;
+
+  // Number of additions, removals, moves and durability changes since the start of the game
+  // (tells how much the world has changed since some moment)
+  unsigned long long ChangesCount() const { return changes_count_; }
+
+ private:
+  static const size_t kNumberOfVehicleTypes = static_cast<size_t>(model::VehicleType::_COUNT_);
+
+  struct TypeTotals {
+    int count[kNumberOfVehicleTypes] = {};
+    double sum_x[kNumberOfVehicleTypes] = {};
+    double sum_y[kNumberOfVehicleTypes] = {};
+    int selected_count[kNumberOfVehicleTypes] = {};
+  };
+
+  // Adds (sign = 1) or subtracts (sign = -1) vehicle in the slot to/from the running totals
+  void AccountInTotals(const size_t slot, const int sign);
+  TypeTotals& TotalsForPlayer(const long long player_id);
+  const TypeTotals* FindTotalsForPlayer(const long long player_id) const;
+
+  // Adds the current position of the vehicle in the slot to its position history
+  void RecordPosition(const size_t slot, const int current_tick);
+
+  // There are only two players, so a linear lookup is the fastest one
+  std::vector<long long> totals_player_ids_;
+  std::vector<TypeTotals> totals_by_player_;
+
+  std::vector<size_t> slot_by_id_;
+
+  std::vector<long long> ids_;
+  std::vector<double> xs_;
+  std::vector<double> ys_;
+  std::vector<int> durabilities_;
+  std::vector<int> max_durabilities_;
+  std::vector<double> vision_ranges_;
+  std::vector<model::VehicleType> types_;
+  std::vector<long long> player_ids_;
+  std::vector<int> move_ticks_;
+  std::vector<int> update_ticks_;
+  std::vector<char> is_selected_;
+
+  // Position history: ring of the slot s is [s * kPositionHistoryLength; (s + 1) * kPositionHistoryLength),
+  // positions are recorded only when the vehicle moves, so a gap between the ticks means it stood still
+  std::vector<int> history_ticks_;
+  std::vector<double> history_xs_;
+  std::vector<double> history_ys_;
+  std::vector<unsigned char> history_newest_; // index of the latest record in the ring
+  std::vector<unsigned char> history_sizes_;
+
+  unsigned long long changes_count_ = 0;
+};
+
+#endif
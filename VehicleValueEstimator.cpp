@@ -1,9 +1,14 @@
 #include "VehicleValueEstimator.h"
 
 int VehicleValueEstimator::CalculateVehicleValue(const model::Vehicle& vehicle, const model::Player& me) const {
-  const bool almost_dying = vehicle.getDurability() * 2 < vehicle.getMaxDurability();
-  const bool is_mine = vehicle.getPlayerId() == me.getId();
-  const bool self_healing = vehicle.getType() == model::VehicleType::ARRV;
+  return CalculateVehicleValue(vehicle.getDurability(), vehicle.getMaxDurability(), vehicle.getType(),
+                               vehicle.getPlayerId() == me.getId());
+}
+
+int VehicleValueEstimator::CalculateVehicleValue(const int durability, const int max_durability,
+                                                 const model::VehicleType& vehicle_type, const bool is_mine) const {
+  const bool almost_dying = durability * 2 < max_durability;
+  const bool self_healing = vehicle_type == model::VehicleType::ARRV;
 
   int coeff = kStartVehicleValue;
 
@@ -12,6 +12,8 @@
 class VehicleValueEstimator {
  public:
   int CalculateVehicleValue(const model::Vehicle& vehicle, const model::Player& me) const;
+  int CalculateVehicleValue(const int durability, const int max_durability,
+                            const model::VehicleType& vehicle_type, const bool is_mine) const;
 
  private:
   const int kStartVehicleValue = 3;
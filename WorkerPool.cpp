@@ -0,0 +1,143 @@
+#include "WorkerPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+// Cores allowed by the CPU quota of the process's cgroup (v2 or v1), 0 if there's no quota
+size_t CgroupQuotaCores() {
+  double quota = -1;
+  double period = 0;
+  if (std::FILE* file = std::fopen("/sys/fs/cgroup/cpu.max", "r")) {
+    // "max 100000" when there's no quota
+    if (std::fscanf(file, "%lf %lf", &quota, &period) != 2) {
+      quota = -1;
+    }
+    std::fclose(file);
+  }
+  else {
+    std::FILE* quota_file = std::fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+    std::FILE* period_file = std::fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+    if (quota_file && period_file &&
+        (std::fscanf(quota_file, "%lf", &quota) != 1 || std::fscanf(period_file, "%lf", &period) != 1)) {
+      quota = -1;
+    }
+    if (quota_file) {
+      std::fclose(quota_file);
+    }
+    if (period_file) {
+      std::fclose(period_file);
+    }
+  }
+  if (quota <= 0 || period <= 0) {
+    return 0;
+  }
+  return std::max<size_t>(1, static_cast<size_t>(std::ceil(quota / period)));
+}
+#endif
+
+}  // namespace
+
+size_t WorkerPool::DefaultWorkersCount() {
+  const char* workers = std::getenv("MY_STRATEGY_WORKERS");
+  if (workers != nullptr) {
+    const long workers_count = std::strtol(workers, nullptr, 10);
+    if (workers_count > 0) {
+      return static_cast<size_t>(workers_count);
+    }
+  }
+
+#ifdef __linux__
+  // hardware_concurrency() counts all the cores of the machine, even the ones the process may not run on
+  size_t cores = 1;
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    cores = std::max(1, CPU_COUNT(&cpu_set));
+  }
+  const size_t quota_cores = CgroupQuotaCores();
+  if (quota_cores > 0) {
+    cores = std::min(cores, quota_cores);
+  }
+  return cores;
+#else
+  return std::max(1u, std::thread::hardware_concurrency());
+#endif
+}
+
+WorkerPool::WorkerPool(const size_t workers_count) : next_chunk_(0) {
+  for (size_t worker = 1; worker < workers_count; worker++) {
+    threads_.emplace_back(&WorkerPool::WorkerLoop, this, worker);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopping_ = true;
+  }
+  job_started_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkerPool::Run(const size_t chunks_count, const std::function<void(size_t, size_t)>& job) {
+  if (threads_.empty() || chunks_count <= 1) {
+    for (size_t chunk = 0; chunk < chunks_count; chunk++) {
+      job(chunk, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ = &job;
+    chunks_count_ = chunks_count;
+    next_chunk_.store(0);
+    busy_workers_ = threads_.size();
+    job_generation_++;
+  }
+  job_started_.notify_all();
+
+  ProcessChunks(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  job_finished_.wait(lock, [this] { return busy_workers_ == 0; });
+  job_ = nullptr;
+}
+
+void WorkerPool::WorkerLoop(const size_t worker) {
+  unsigned long long seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_started_.wait(lock, [&] { return is_stopping_ || job_generation_ != seen_generation; });
+      if (is_stopping_) {
+        return;
+      }
+      seen_generation = job_generation_;
+    }
+
+    ProcessChunks(worker);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      busy_workers_--;
+    }
+    job_finished_.notify_one();
+  }
+}
+
+void WorkerPool::ProcessChunks(const size_t worker) {
+  for (size_t chunk = next_chunk_.fetch_add(1); chunk < chunks_count_; chunk = next_chunk_.fetch_add(1)) {
+    (*job_)(chunk, worker);
+  }
+}
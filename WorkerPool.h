@@ -0,0 +1,58 @@
+#pragma once
+#ifndef _WORKER_POOL_H_
+#define _WORKER_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed set of threads which evaluate independent chunks of work.
+// The calling thread takes part in the work as worker 0, so a pool of one worker runs everything in place
+// and starts no threads at all.
+// Chunks are taken in any order, so callers store a result per chunk and reduce them in the order of chunks:
+// the outcome is then the same for any number of workers.
+class WorkerPool {
+ public:
+  // Number of cores the strategy is allowed to use (1 if it's unknown):
+  // MY_STRATEGY_WORKERS environment variable if it's set to a positive number,
+  // otherwise the CPUs of the process's affinity mask limited by its cgroup CPU quota.
+  // With a single allowed core, the pool runs everything on the calling thread.
+  static size_t DefaultWorkersCount();
+
+  explicit WorkerPool(const size_t workers_count = DefaultWorkersCount());
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator = (const WorkerPool&) = delete;
+
+  size_t WorkersCount() const { return threads_.size() + 1; }
+
+  // Calls `job(chunk, worker)` for every chunk from [0; chunks_count) and returns when all of them are done.
+  // `worker` (from [0; WorkersCount())) identifies per-worker scratch buffers: no two chunks run on the same
+  // worker at the same time.
+  void Run(const size_t chunks_count, const std::function<void(size_t, size_t)>& job);
+
+ private:
+  void WorkerLoop(const size_t worker);
+  void ProcessChunks(const size_t worker);
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable job_started_;
+  std::condition_variable job_finished_;
+  bool is_stopping_ = false;
+  unsigned long long job_generation_ = 0;
+  size_t busy_workers_ = 0;
+
+  // The job which is being run
+  const std::function<void(size_t, size_t)>* job_ = nullptr;
+  size_t chunks_count_ = 0;
+  std::atomic<size_t> next_chunk_;
+};
+
+#endif
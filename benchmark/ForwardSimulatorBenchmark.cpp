@@ -0,0 +1,61 @@
+// Measures ForwardSimulator on synthetic battles (see SyntheticWorld.h) of different sizes and layouts:
+// all my vehicles are shifted by a quarter of the world diagonally, and the battle is rolled forward for a number of ticks.
+// Prints one CSV line per battle:
+// layout,vehicles,ticks,repetitions,mean_ms,min_ms,my_alive,enemy_alive
+//
+// Build it from the directory with the strategy and cgdk sources (Runner.cpp is excluded because it has its own main):
+// g++ -std=c++14 -O3 -pthread -I. -Ibenchmark benchmark/ForwardSimulatorBenchmark.cpp benchmark/SyntheticWorld.cpp
+//     $(ls *.cpp | grep -v -e Runner.cpp -e RemoteProcessClient.cpp) model/*.cpp -o forward_simulator_benchmark
+
+#include "ForwardSimulator.h"
+#include "GoTo.h"
+#include "Select.h"
+#include "SyntheticWorld.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace model;
+
+int main() {
+  const Game game = SyntheticWorldGenerator::MakeGame();
+  const World world = SyntheticWorldGenerator::MakeWorld(0, {}, {}, false);
+  const auto rules = std::make_shared<SimulationRules>(world, game);
+  const double kWorldSideLength = SyntheticWorldGenerator::WorldSideLength();
+  const int kTicks = 100;
+  const int kRepetitions = 20;
+
+  printf("layout,vehicles,ticks,repetitions,mean_ms,min_ms,my_alive,enemy_alive\n");
+  for (const SyntheticLayout layout : { SyntheticLayout::INITIAL_FORMATIONS, SyntheticLayout::MELEE }) {
+    for (const size_t vehicles_count : { 500, 1000, 2000 }) {
+      SyntheticWorldGenerator generator(static_cast<unsigned int>(vehicles_count));
+      VehicleStore vehicles;
+      for (const Vehicle& vehicle : generator.MakeVehicles(vehicles_count, layout)) {
+        vehicles.Add(vehicle, 0);
+      }
+      ForwardSimulator loaded(rules);
+      loaded.Load(vehicles, SyntheticWorldGenerator::kMyId);
+      loaded.Apply(Select(Vect(0, 0), Vect(kWorldSideLength, kWorldSideLength)));
+      loaded.Apply(GoTo(Vect(kWorldSideLength / 4, kWorldSideLength / 4)));
+
+      double sum_ms = 0;
+      double min_ms = 1e9;
+      ForwardSimulator simulator = loaded;
+      for (int repetition = 0; repetition < kRepetitions; repetition++) {
+        simulator = loaded;
+        const auto start = std::chrono::steady_clock::now();
+        simulator.Simulate(kTicks);
+        const auto finish = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(finish - start).count();
+        sum_ms += ms;
+        min_ms = std::min(min_ms, ms);
+      }
+      printf("%s,%zu,%d,%d,%.3f,%.3f,%d,%d\n", SyntheticWorldGenerator::LayoutName(layout), vehicles_count, kTicks,
+             kRepetitions, sum_ms / kRepetitions, min_ms, simulator.AliveCount(true), simulator.AliveCount(false));
+    }
+  }
+  return 0;
+}
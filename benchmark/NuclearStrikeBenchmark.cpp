@@ -0,0 +1,199 @@
+// Measures NuclearAttackHandler::TryNuclearStrike on synthetic worlds of different sizes
+// and compares its choice against a brute-force evaluation of the same rule for every launcher candidate
+// (same_choice tells that the two agree, not that the choice is the one of earlier versions of the handler).
+//
+// Build it from the directory with the strategy and cgdk sources (Runner.cpp is excluded because it has its own main):
+// g++ -std=c++14 -O2 -pthread -I. -Ibenchmark benchmark/NuclearStrikeBenchmark.cpp benchmark/SyntheticWorld.cpp
+//     $(ls *.cpp | grep -v -e Runner.cpp -e RemoteProcessClient.cpp) model/*.cpp -o nuclear_strike_benchmark
+
+#include "NuclearAttackHandler.h"
+#include "NuclearStrike.h"
+#include "SyntheticWorld.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace model;
+
+namespace {
+
+const double kWorldSideLength = SyntheticWorldGenerator::WorldSideLength();
+const long long kMyId = SyntheticWorldGenerator::kMyId;
+const long long kEnemyId = SyntheticWorldGenerator::kEnemyId;
+
+// Scatters vehicles of both players in several dense clusters (the way armies look in a melee)
+void FillStore(const size_t vehicles_count, VehicleStore& vehicles, SpatialGrid& grid) {
+  std::mt19937 random_engine(static_cast<unsigned int>(vehicles_count));
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::normal_distribution<double> spread(0, 40);
+  const size_t kClusters = 12;
+  std::vector<Vect> cluster_centers;
+  for (size_t i = 0; i < kClusters; i++) {
+    cluster_centers.emplace_back(100 + uniform(random_engine) * (kWorldSideLength - 200),
+                                 100 + uniform(random_engine) * (kWorldSideLength - 200));
+  }
+  for (size_t i = 0; i < vehicles_count; i++) {
+    const Vect& center = cluster_centers[random_engine() % kClusters];
+    const double x = std::min(kWorldSideLength - 1, std::max(1.0, center.x + spread(random_engine)));
+    const double y = std::min(kWorldSideLength - 1, std::max(1.0, center.y + spread(random_engine)));
+    const long long id = static_cast<long long>(i) + 1;
+    const long long player_id = random_engine() % 2 == 0 ? kMyId : kEnemyId;
+    const VehicleType type = static_cast<VehicleType>(random_engine() % 5);
+    vehicles.Add(SyntheticWorldGenerator::MakeVehicle(id, Vect(x, y), player_id, type, 1 + random_engine() % 100), 0);
+    grid.Insert(id);
+  }
+}
+
+struct StrikeChoice {
+  long long launcher_id = -1;
+  Vect target;
+};
+
+StrikeChoice ChoiceFromActions(const ActionScheduler& actions) {
+  StrikeChoice choice;
+  if (!actions.Empty()) {
+    Move move;
+    actions.Front().Execute(move);
+    choice.launcher_id = move.getVehicleId();
+    choice.target = Vect(move.getX(), move.getY());
+  }
+  return choice;
+}
+
+// Brute-force evaluation of the same rule: every candidate aims at the mass center of the enemies
+// within half of its vision range, and every vehicle in the world is checked against the strike at that point
+StrikeChoice ReferenceStrikeChoice(const VehicleStore& vehicles, const RuntimeConstants& constants,
+                                   const VehicleValueEstimator& estimator, const int min_enemies_cnt) {
+  std::vector<std::vector<size_t>> launcher_slot_by_fragment(
+    constants.kDoubledFragmentsLinearCount,
+    std::vector<size_t>(constants.kDoubledFragmentsLinearCount, VehicleStore::kNoSlot));
+  for (size_t slot = 0; slot < vehicles.Size(); slot++) {
+    if (vehicles.PlayerId(slot) == kMyId) {
+      const int x_cell = vehicles.X(slot) / constants.kDoubledFragmentSideLength;
+      const int y_cell = vehicles.Y(slot) / constants.kDoubledFragmentSideLength;
+      size_t& representative = launcher_slot_by_fragment[x_cell][y_cell];
+      if (representative == VehicleStore::kNoSlot || vehicles.Id(slot) < vehicles.Id(representative)) {
+        representative = slot;
+      }
+    }
+  }
+  std::vector<std::pair<long long, size_t>> launchers;
+  for (const auto& fragments_column : launcher_slot_by_fragment) {
+    for (const size_t slot : fragments_column) {
+      if (slot != VehicleStore::kNoSlot) {
+        launchers.emplace_back(vehicles.Id(slot), slot);
+      }
+    }
+  }
+  std::sort(launchers.begin(), launchers.end());
+
+  // {balance; enemies count} of a strike at `center`
+  const auto score_strike = [&](const Vect& center, const double range) {
+    std::pair<int, int> score(0, 0);
+    for (size_t target = 0; target < vehicles.Size(); target++) {
+      if ((vehicles.Position(target) - center).Length() < range) {
+        const bool is_mine = vehicles.PlayerId(target) == kMyId;
+        score.first += estimator.CalculateVehicleValue(vehicles.Durability(target), vehicles.MaxDurability(target),
+                                                       vehicles.Type(target), is_mine);
+        score.second += is_mine ? 0 : 1;
+      }
+    }
+    return score;
+  };
+
+  int best_cnt = 0;
+  int best_balance = 0;
+  StrikeChoice best;
+  for (const auto& id_and_slot : launchers) {
+    const size_t launcher = id_and_slot.second;
+    int cnt = 0;
+    Vect sum_position;
+    for (size_t target = 0; target < vehicles.Size(); target++) {
+      if (vehicles.PlayerId(target) != kMyId &&
+          (vehicles.Position(target) - vehicles.Position(launcher)).Length() < vehicles.VisionRange(launcher) / 2) {
+        cnt++;
+        sum_position += vehicles.Position(target);
+      }
+    }
+    if (cnt == 0) {
+      continue;
+    }
+    const Vect target = sum_position / cnt;
+    const std::pair<int, int> score = score_strike(target, constants.kTacticalNuclearStrikeRadius);
+    if (score.first > best_balance) {
+      best_balance = score.first;
+      best_cnt = score.second;
+      best.launcher_id = id_and_slot.first;
+      best.target = target;
+    }
+  }
+  if (best_cnt < min_enemies_cnt) {
+    return StrikeChoice();
+  }
+  return best;
+}
+
+template <typename Function>
+double MeasureMicroseconds(const int repetitions, Function function) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; i++) {
+    function();
+  }
+  const auto finish = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(finish - start).count() / repetitions;
+}
+
+}  // namespace
+
+int main() {
+  const Game game = SyntheticWorldGenerator::MakeGame();
+  const World world = SyntheticWorldGenerator::MakeWorld(0, {}, {}, false);
+  const Player me = world.getMyPlayer();
+  const int kRepetitions = 20;
+  const int kMinEnemiesCountDeservingNukes = 10;
+
+  printf("vehicles,workers,reference_us,indexed_us,speedup,same_choice\n");
+  for (const size_t vehicles_count : { 500, 2000, 10000 }) {
+    for (const size_t workers_count : { 1, 4 }) {
+      VehicleStore vehicles;
+      const auto runtime_constants = std::make_shared<RuntimeConstants>(world, game);
+      const auto spatial_grid = std::make_shared<SpatialGrid>(vehicles, runtime_constants->kWorldSideLength,
+                                                              runtime_constants->kFragmentSideLength);
+      const auto estimator = std::make_shared<VehicleValueEstimator>();
+      const auto motionlessness_checker = std::make_shared<MotionlessnessChecker>(
+        vehicles, kMyId, static_cast<int>(VehicleType::_COUNT_));
+      const auto worker_pool = std::make_shared<WorkerPool>(workers_count);
+      const auto cpu_governor = std::make_shared<CpuGovernor>(
+        CpuGovernor::BudgetFromEnvironment(world.getTickCount()), world.getTickCount(),
+        runtime_constants->kBaseUniformActionInterval);
+      NuclearAttackHandler handler(vehicles, spatial_grid, estimator, runtime_constants, motionlessness_checker,
+                                   worker_pool, cpu_governor);
+      FillStore(vehicles_count, vehicles, *spatial_grid);
+
+      StrikeChoice reference;
+      const double reference_us = MeasureMicroseconds(kRepetitions, [&]() {
+        reference = ReferenceStrikeChoice(vehicles, *runtime_constants, *estimator, kMinEnemiesCountDeservingNukes);
+      });
+
+      // every call is made on its own tick, so that vehicle values aren't reused between the calls
+      StrikeChoice indexed;
+      int tick = 0;
+      const double indexed_us = MeasureMicroseconds(kRepetitions, [&]() {
+        ActionScheduler actions;
+        handler.TryNuclearStrike(me, tick++, actions);
+        indexed = ChoiceFromActions(actions);
+      });
+
+      const bool same_choice = reference.launcher_id == indexed.launcher_id &&
+                               (reference.target - indexed.target).Length() < 1e-6;
+      printf("%zu,%zu,%.1f,%.1f,%.2f,%s\n", vehicles_count, workers_count, reference_us, indexed_us,
+             reference_us / indexed_us, same_choice ? "yes" : "no");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,213 @@
+// Measures the hot functions of DecisionMaker and its helpers on synthetic worlds
+// (see SyntheticWorld.h) of different sizes and layouts.
+// Prints one CSV line per benchmark, so that results of two builds can be compared with any diff/CSV tool:
+// benchmark,layout,vehicles,repetitions,mean_us,min_us,items_per_second
+// (an item is a call for queries and a vehicle update for update_vehicle_info).
+//
+// Usage: strategy_benchmark [vehicles_count...]   (1000 10000 100000 by default)
+//
+// Build it from the directory with the strategy and cgdk sources (Runner.cpp is excluded because it has its own main):
+// g++ -std=c++14 -O2 -pthread -I. -Ibenchmark benchmark/StrategyBenchmark.cpp benchmark/SyntheticWorld.cpp
+//     $(ls *.cpp | grep -v -e Runner.cpp -e RemoteProcessClient.cpp) model/*.cpp -o strategy_benchmark
+
+#include "DecisionMakerForGameWithBuildings.h"
+#include "DecisionMakerForGameWithoutBuildings.h"
+#include "SyntheticWorld.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace model;
+
+// Decision makers with the measured protected methods made public
+class BenchmarkedGameWithoutBuildings : public DecisionMakerForGameWithoutBuildings {
+ public:
+  using DecisionMaker::kAllVehicles;
+  using DecisionMaker::ClosestEnemyPosition;
+  using DecisionMaker::MassCenterForVehiclesByTypes;
+  using DecisionMakerForGameWithoutBuildings::DistanceBetweenMyAirVehiclesAndEnemyVehicles;
+
+  NuclearAttackHandler& Nuclear() const { return *nuclear_attack_handler_; }
+};
+
+class BenchmarkedGameWithBuildings : public DecisionMakerForGameWithBuildings {
+ public:
+  using DecisionMaker::kGroundVehicles;
+  using DecisionMakerForGameWithBuildings::BoundsForMultipleUnitsClosestToPoint;
+};
+
+class StrategyBenchmark {
+ public:
+  StrategyBenchmark(const size_t vehicles_count, const SyntheticLayout& layout);
+
+  void Run();
+
+  // Combination of all results, printed so that the compiler can't throw the measured calls away
+  double Checksum() const { return checksum_; }
+
+ private:
+  struct Measurement {
+    int repetitions = 0;
+    double mean_us = 0;
+    double min_us = 0;
+  };
+
+  // Runs `function` (with the repetition index) until both kMinRepetitions and kMinDuration are reached
+  template <typename Function>
+  Measurement Measure(Function function) const;
+
+  void Print(const char* benchmark, const Measurement& measurement, const size_t items_per_repetition) const;
+
+  const Vect& Anchor(const int repetition) const { return anchors_[repetition % anchors_.size()]; }
+
+  const int kMinRepetitions = 5;
+  const std::chrono::milliseconds kMinDuration = std::chrono::milliseconds(200);
+  const size_t kAnchorsCount = 64;
+  const size_t kUpdateBatchesCount = 4;
+  const double kMaxShiftPerTick = 0.6;
+  const size_t kBrigadeSize = 10;
+
+  const size_t vehicles_count_;
+  const SyntheticLayout layout_;
+  const Game game_;
+  const Player me_;
+
+  SyntheticWorldGenerator generator_;
+  std::vector<Vehicle> vehicles_;
+  std::vector<Vect> anchors_;
+
+  double checksum_ = 0;
+};
+
+StrategyBenchmark::StrategyBenchmark(const size_t vehicles_count, const SyntheticLayout& layout)
+    : vehicles_count_(vehicles_count),
+      layout_(layout),
+      game_(SyntheticWorldGenerator::MakeGame()),
+      me_(SyntheticWorldGenerator::MakeWorld(0, {}, {}, false).getMyPlayer()),
+      generator_(static_cast<unsigned int>(vehicles_count * 3 + static_cast<size_t>(layout))) {
+  vehicles_ = generator_.MakeVehicles(vehicles_count_, layout_);
+  for (size_t i = 0; i < kAnchorsCount; i++) {
+    anchors_.push_back(generator_.RandomPoint());
+  }
+}
+
+void StrategyBenchmark::Run() {
+  const World world = SyntheticWorldGenerator::MakeWorld(0, vehicles_, {}, false);
+  BenchmarkedGameWithoutBuildings without_buildings;
+  without_buildings.InitializeHelperClasses(world, game_);
+  for (const Vehicle& vehicle : vehicles_) {
+    without_buildings.AddNewVehicleInfo(vehicle, 0);
+  }
+
+  const World world_with_buildings = SyntheticWorldGenerator::MakeWorld(0, vehicles_, {}, true);
+  BenchmarkedGameWithBuildings with_buildings;
+  with_buildings.InitializeHelperClasses(world_with_buildings, game_);
+  for (const Vehicle& vehicle : vehicles_) {
+    with_buildings.AddNewVehicleInfo(vehicle, 0);
+  }
+
+  Print("closest_enemy_position", Measure([&](const int repetition) {
+    checksum_ += without_buildings.ClosestEnemyPosition(me_, Anchor(repetition)).x;
+  }), 1);
+
+  Print("mass_center_for_vehicles_by_types", Measure([&](const int) {
+    checksum_ += without_buildings.MassCenterForVehiclesByTypes(me_, without_buildings.kAllVehicles).x;
+  }), 1);
+
+  Print("distance_between_my_air_vehicles_and_enemy_vehicles", Measure([&](const int) {
+    checksum_ += without_buildings.DistanceBetweenMyAirVehiclesAndEnemyVehicles(me_);
+  }), 1);
+
+  Print("bounds_for_multiple_units_closest_to_point", Measure([&](const int repetition) {
+    const std::vector<VehicleType>& ground_vehicles = with_buildings.kGroundVehicles;
+    const VehicleType& type = ground_vehicles[repetition % ground_vehicles.size()];
+    checksum_ += with_buildings.BoundsForMultipleUnitsClosestToPoint(me_, type, Anchor(repetition), kBrigadeSize).first.x;
+  }), 1);
+
+  Print("find_square_with_largest_potential_for_nuclear_strike", Measure([&](const int) {
+    checksum_ += without_buildings.Nuclear().FindSquareWithLargestPotentialForNuclearStrike(me_).x;
+  }), 1);
+
+  ActionScheduler actions;
+  // every call is made on its own tick, so that vehicle values aren't reused between the calls
+  Print("try_nuclear_strike", Measure([&](const int repetition) {
+    while (!actions.Empty()) {
+      actions.PopFront();
+    }
+    without_buildings.Nuclear().TryNuclearStrike(me_, repetition, actions);
+    checksum_ += actions.Size();
+  }), 1);
+
+  // Every vehicle moves on every tick, which is the worst case for ingestion
+  std::vector<Vehicle> moving_vehicles = vehicles_;
+  std::vector<std::vector<VehicleUpdate>> update_batches;
+  for (size_t i = 0; i < kUpdateBatchesCount; i++) {
+    update_batches.push_back(generator_.MakeUpdates(moving_vehicles, kMaxShiftPerTick));
+  }
+  BenchmarkedGameWithoutBuildings ingesting;
+  ingesting.InitializeHelperClasses(world, game_);
+  for (const Vehicle& vehicle : vehicles_) {
+    ingesting.AddNewVehicleInfo(vehicle, 0);
+  }
+  Print("update_vehicle_info", Measure([&](const int repetition) {
+    for (const VehicleUpdate& vehicle_update : update_batches[repetition % update_batches.size()]) {
+      ingesting.UpdateVehicleInfo(vehicle_update, repetition + 1);
+    }
+  }), vehicles_count_);
+  checksum_ += ingesting.MassCenterForVehiclesByTypes(me_, ingesting.kAllVehicles).x;
+}
+
+template <typename Function>
+StrategyBenchmark::Measurement StrategyBenchmark::Measure(Function function) const {
+  Measurement measurement;
+  measurement.min_us = 1e100;
+  double total_us = 0;
+  const auto start = std::chrono::steady_clock::now();
+  while (measurement.repetitions < kMinRepetitions || std::chrono::steady_clock::now() - start < kMinDuration) {
+    const auto repetition_start = std::chrono::steady_clock::now();
+    function(measurement.repetitions);
+    const auto repetition_finish = std::chrono::steady_clock::now();
+    const double repetition_us = std::chrono::duration<double, std::micro>(repetition_finish - repetition_start).count();
+    total_us += repetition_us;
+    measurement.min_us = std::min(measurement.min_us, repetition_us);
+    measurement.repetitions++;
+  }
+  measurement.mean_us = total_us / measurement.repetitions;
+  return measurement;
+}
+
+void StrategyBenchmark::Print(const char* benchmark, const Measurement& measurement,
+                              const size_t items_per_repetition) const {
+  const double kMicrosecondsInSecond = 1e6;
+  printf("%s,%s,%zu,%d,%.3f,%.3f,%.0f\n", benchmark, SyntheticWorldGenerator::LayoutName(layout_),
+         vehicles_count_, measurement.repetitions, measurement.mean_us, measurement.min_us,
+         items_per_repetition * kMicrosecondsInSecond / measurement.mean_us);
+  fflush(stdout);
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<size_t> vehicles_counts;
+  for (int i = 1; i < argc; i++) {
+    vehicles_counts.push_back(static_cast<size_t>(std::strtoul(argv[i], nullptr, 10)));
+  }
+  if (vehicles_counts.empty()) {
+    vehicles_counts = { 1000, 10000, 100000 };
+  }
+
+  double checksum = 0;
+  printf("benchmark,layout,vehicles,repetitions,mean_us,min_us,items_per_second\n");
+  for (const SyntheticLayout layout : { SyntheticLayout::INITIAL_FORMATIONS, SyntheticLayout::MELEE,
+                                        SyntheticLayout::SCATTERED }) {
+    for (const size_t vehicles_count : vehicles_counts) {
+      StrategyBenchmark benchmark(vehicles_count, layout);
+      benchmark.Run();
+      checksum += benchmark.Checksum();
+    }
+  }
+  fprintf(stderr, "checksum: %.6f\n", checksum);
+  return 0;
+}
@@ -0,0 +1,185 @@
+#include "SyntheticWorld.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace model;
+
+namespace {
+
+const double kWorldSideLength = 1024;
+const double kVehicleRadius = 2;
+
+// Initial formations occupy 5 of 9 slots of a 3x3 grid in the corner of the world
+const double kFormationSlotOffset = 18;
+const double kFormationSlotStep = 74;
+const double kFormationSlotSide = 54;
+const double kMaxFormationSpacing = 6;
+const int kFormationSlots[][2] = { { 0, 0 }, { 1, 0 }, { 0, 1 }, { 2, 1 }, { 1, 2 } }; // by VehicleType
+
+const size_t kMeleeClustersCount = 12;
+const double kMeleeClusterSpread = 40;
+
+Vect ClampToWorld(const Vect& position) {
+  return Vect(std::min(kWorldSideLength - 1, std::max(1.0, position.x)),
+              std::min(kWorldSideLength - 1, std::max(1.0, position.y)));
+}
+
+// Draws x before y (the order of evaluation of function arguments is unspecified)
+template <typename Distribution>
+Vect RandomVect(Distribution& distribution, std::mt19937& random_engine) {
+  const double x = distribution(random_engine);
+  const double y = distribution(random_engine);
+  return Vect(x, y);
+}
+
+Vehicle MovedVehicle(const Vehicle& v, const Vect& position) {
+  return Vehicle(v.getId(), position.x, position.y, v.getRadius(), v.getPlayerId(), v.getDurability(),
+                 v.getMaxDurability(), v.getMaxSpeed(), v.getVisionRange(), v.getSquaredVisionRange(),
+                 v.getGroundAttackRange(), v.getSquaredGroundAttackRange(), v.getAerialAttackRange(),
+                 v.getSquaredAerialAttackRange(), v.getGroundDamage(), v.getAerialDamage(), v.getGroundDefence(),
+                 v.getAerialDefence(), v.getAttackCooldownTicks(), v.getRemainingAttackCooldownTicks(),
+                 v.getType(), v.isAerial(), v.isSelected(), v.getGroups());
+}
+
+}  // namespace
+
+SyntheticWorldGenerator::SyntheticWorldGenerator(const unsigned int seed) : random_engine_(seed) {}
+
+double SyntheticWorldGenerator::WorldSideLength() {
+  return kWorldSideLength;
+}
+
+const char* SyntheticWorldGenerator::LayoutName(const SyntheticLayout& layout) {
+  switch (layout) {
+    case SyntheticLayout::INITIAL_FORMATIONS: return "initial_formations";
+    case SyntheticLayout::MELEE: return "melee";
+    case SyntheticLayout::SCATTERED: return "scattered";
+  }
+  return "unknown";
+}
+
+Game SyntheticWorldGenerator::MakeGame() {
+  return Game(
+    42, 20000, kWorldSideLength, kWorldSideLength, true,  // random seed, ticks, world size, fog of war
+    1000, 100, 1, 60, 12, 3, 100, 32, 32,                  // scores, actions, groups, terrain/weather map size
+    1.0, 1.0, 1.0, 1.0, 1.0, 0.6, 0.8, 0.6, 0.8,           // terrain factors: plain, swamp, forest
+    1.0, 1.0, 1.0, 0.8, 0.6, 0.8, 0.6, 0.6, 0.6,           // weather factors: clear, cloud, rain
+    kVehicleRadius,                                        // vehicle radius
+    100, 0.3, 80, 20, 18, 100, 60, 80, 60, 60, 60,         // tank
+    100, 0.4, 80, 18, 20, 90, 80, 60, 80, 60, 60,          // IFV
+    100, 0.4, 60, 50, 50, 60, 10, 0.03,                    // ARRV
+    100, 0.9, 100, 20, 18, 100, 80, 40, 40, 60, 60,        // helicopter
+    100, 1.2, 120, 0, 20, 0, 90, 70, 70, 60, 60,           // fighter
+    100, 1, 64, 64,                                        // facilities
+    1200, 60, 99, 50, 30);                                 // tactical nuclear strike
+}
+
+World SyntheticWorldGenerator::MakeWorld(const int tick, const std::vector<Vehicle>& new_vehicles,
+                                         const std::vector<VehicleUpdate>& vehicle_updates,
+                                         const bool with_facilities) {
+  const std::vector<Player> players = {
+    Player(kMyId, true, false, 0, 0, 0, -1, -1, 0, 0),
+    Player(kEnemyId, false, false, 0, 0, 0, -1, -1, 0, 0) };
+  std::vector<Facility> facilities;
+  if (with_facilities) {
+    const double facility_coordinates[] = { 160, 480, 800 };
+    long long id = 1;
+    for (const double left : facility_coordinates) {
+      for (const double top : facility_coordinates) {
+        const FacilityType type = id % 2 ? FacilityType::CONTROL_CENTER : FacilityType::VEHICLE_FACTORY;
+        facilities.emplace_back(id++, type, -1, left, top, 0, VehicleType::_UNKNOWN_, 0);
+      }
+    }
+  }
+  return World(tick, MakeGame().getTickCount(), kWorldSideLength, kWorldSideLength, players,
+               new_vehicles, vehicle_updates,
+               std::vector<std::vector<TerrainType>>(32, std::vector<TerrainType>(32, TerrainType::PLAIN)),
+               std::vector<std::vector<WeatherType>>(32, std::vector<WeatherType>(32, WeatherType::CLEAR)),
+               facilities);
+}
+
+Vehicle SyntheticWorldGenerator::MakeVehicle(const long long id, const Vect& position, const long long player_id,
+                                             const VehicleType& type, const int durability) {
+  const double vision_ranges[] = { 60, 120, 100, 80, 80 }; // by VehicleType
+  const double vision_range = vision_ranges[static_cast<size_t>(type)];
+  const bool aerial = type == VehicleType::FIGHTER || type == VehicleType::HELICOPTER;
+  return Vehicle(id, position.x, position.y, kVehicleRadius, player_id, durability, 100, 1, vision_range,
+                 vision_range * vision_range, 20, 400, 20, 400, 100, 100, 50, 50, 60, 0,
+                 type, aerial, false, std::vector<int>());
+}
+
+std::vector<Vehicle> SyntheticWorldGenerator::MakeVehicles(const size_t count, const SyntheticLayout& layout) {
+  std::uniform_real_distribution<double> uniform(0, kWorldSideLength);
+  std::normal_distribution<double> spread(0, kMeleeClusterSpread);
+  std::vector<Vect> cluster_centers;
+  for (size_t i = 0; i < kMeleeClustersCount; i++) {
+    cluster_centers.push_back(Vect(kWorldSideLength / 4, kWorldSideLength / 4) +
+                              RandomVect(uniform, random_engine_) / 2);
+  }
+
+  std::vector<Vehicle> vehicles;
+  vehicles.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    const long long id = static_cast<long long>(i) + 1;
+    const long long player_id = i % 2 == 0 ? kMyId : kEnemyId;
+    VehicleType type = static_cast<VehicleType>(random_engine_() % static_cast<int>(VehicleType::_COUNT_));
+    Vect position;
+    switch (layout) {
+      case SyntheticLayout::INITIAL_FORMATIONS:
+        position = InitialFormationPosition(i, count, type);
+        break;
+      case SyntheticLayout::MELEE: {
+        const Vect& center = cluster_centers[random_engine_() % kMeleeClustersCount];
+        position = ClampToWorld(center + RandomVect(spread, random_engine_));
+        break;
+      }
+      case SyntheticLayout::SCATTERED:
+        position = ClampToWorld(RandomVect(uniform, random_engine_));
+        break;
+    }
+    const int durability = 1 + random_engine_() % 100;
+    vehicles.push_back(MakeVehicle(id, position, player_id, type, durability));
+  }
+  return vehicles;
+}
+
+// Vehicles are dealt to players in turn and then to the blocks of their types in turn,
+// so every block gets about count / 10 vehicles arranged in a square
+Vect SyntheticWorldGenerator::InitialFormationPosition(const size_t index, const size_t count,
+                                                       VehicleType& type) const {
+  const size_t types_count = static_cast<size_t>(VehicleType::_COUNT_);
+  const size_t index_in_player = index / 2;
+  type = static_cast<VehicleType>(index_in_player % types_count);
+  const size_t index_in_block = index_in_player / types_count;
+
+  const size_t block_size = std::max<size_t>(1, (count + 2 * types_count - 1) / (2 * types_count));
+  const size_t block_side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(block_size))));
+  const double spacing = block_side > 1 ?
+                         std::min(kMaxFormationSpacing, kFormationSlotSide / (block_side - 1)) : 0;
+
+  const int* slot = kFormationSlots[static_cast<size_t>(type)];
+  const Vect position(kFormationSlotOffset + slot[0] * kFormationSlotStep + (index_in_block % block_side) * spacing,
+                      kFormationSlotOffset + slot[1] * kFormationSlotStep + (index_in_block / block_side) * spacing);
+  // The enemy's formations are mirrored into the opposite corner
+  return index % 2 == 0 ? position : Vect(kWorldSideLength, kWorldSideLength) - position;
+}
+
+std::vector<VehicleUpdate> SyntheticWorldGenerator::MakeUpdates(std::vector<Vehicle>& vehicles,
+                                                                const double max_shift) {
+  std::uniform_real_distribution<double> shift(-max_shift, max_shift);
+  std::vector<VehicleUpdate> vehicle_updates;
+  vehicle_updates.reserve(vehicles.size());
+  for (Vehicle& vehicle : vehicles) {
+    const Vect position = ClampToWorld(Vect(vehicle) + RandomVect(shift, random_engine_));
+    vehicle_updates.emplace_back(vehicle.getId(), position.x, position.y, vehicle.getDurability(),
+                                 vehicle.getRemainingAttackCooldownTicks(), vehicle.isSelected(), std::vector<int>());
+    vehicle = MovedVehicle(vehicle, position);
+  }
+  return vehicle_updates;
+}
+
+Vect SyntheticWorldGenerator::RandomPoint() {
+  std::uniform_real_distribution<double> uniform(0, kWorldSideLength);
+  return RandomVect(uniform, random_engine_);
+}
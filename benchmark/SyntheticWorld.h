@@ -0,0 +1,56 @@
+#pragma once
+#ifndef _SYNTHETIC_WORLD_H_
+#define _SYNTHETIC_WORLD_H_
+
+#include "Strategy.h"
+#include "Vect.h"
+#include <random>
+#include <vector>
+
+// How vehicles are spread over the world
+enum class SyntheticLayout {
+  INITIAL_FORMATIONS, // both players start in corners: a square block per vehicle type, as at the start of a game
+  MELEE,              // both armies are mixed in several dense clusters in the middle of the world
+  SCATTERED           // vehicles are uniformly spread over the whole world
+};
+
+// Deterministically generates game constants, players and vehicles for benchmarks
+// (the same seed always gives the same world)
+class SyntheticWorldGenerator {
+ public:
+  static const long long kMyId = 1;
+  static const long long kEnemyId = 2;
+
+  explicit SyntheticWorldGenerator(const unsigned int seed);
+
+  static double WorldSideLength();
+  static const char* LayoutName(const SyntheticLayout& layout);
+
+  // Constants of a real game (with fog of war)
+  static model::Game MakeGame();
+
+  // World with both players; facilities are added if `with_facilities` is set
+  static model::World MakeWorld(const int tick, const std::vector<model::Vehicle>& new_vehicles,
+                                const std::vector<model::VehicleUpdate>& vehicle_updates,
+                                const bool with_facilities);
+
+  static model::Vehicle MakeVehicle(const long long id, const Vect& position, const long long player_id,
+                                    const model::VehicleType& type, const int durability);
+
+  // `count` vehicles with IDs 1..count, half of them (rounded up) are mine
+  std::vector<model::Vehicle> MakeVehicles(const size_t count, const SyntheticLayout& layout);
+
+  // Moves every vehicle by up to `max_shift` in a random direction (staying inside the world)
+  // and changes positions in `vehicles` accordingly
+  std::vector<model::VehicleUpdate> MakeUpdates(std::vector<model::Vehicle>& vehicles, const double max_shift);
+
+  // Random point inside the world
+  Vect RandomPoint();
+
+ private:
+  Vect InitialFormationPosition(const size_t index, const size_t count, model::VehicleType& type) const;
+
+  std::mt19937 random_engine_;
+};
+
+#endif
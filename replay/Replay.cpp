@@ -0,0 +1,239 @@
+// Replays a game recorded by TickRecorder (see TickRecording.h) through MyStrategy without the game runner
+// and prints the actions the strategy makes, one line per tick with an action.
+// The strategy is deterministic, so replaying the same recording always prints the same actions.
+// Two things in it depend on timing, so the replay switches them off (unless the variables are set already):
+// - CpuGovernor's quality level: MY_STRATEGY_QUALITY_LEVEL pins it to FULL (or to the level it's set to);
+// - the wall-clock cap of ChainPlanner: MY_STRATEGY_NO_PLANNING_DEADLINE leaves only its budget of vehicle-ticks.
+//
+// Usage: replay <recording> [--quiet]
+// (--quiet prints only the summary: number of ticks, time spent and a hash of all actions)
+//
+// Build it from the directory with the strategy and cgdk sources (Runner.cpp is excluded because it has its own main):
+// g++ -std=c++14 -O2 -pthread -I. replay/Replay.cpp
+//     $(ls *.cpp | grep -v -e Runner.cpp -e RemoteProcessClient.cpp) model/*.cpp -o replay_strategy
+// To record a game, build the strategy with -DMY_STRATEGY_RECORDING.
+// With -DMY_STRATEGY_PROFILING, the replay also prints durations of the strategy's phases (see Profiler.h).
+
+#include "MyStrategy.h"
+#include "TickRecording.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace model;
+
+namespace {
+
+// Read-only view of a whole file mapped into memory
+class MappedFile {
+ public:
+  explicit MappedFile(const char* file_name) {
+    const int descriptor = open(file_name, O_RDONLY);
+    if (descriptor < 0) {
+      return;
+    }
+    struct stat file_stat;
+    if (fstat(descriptor, &file_stat) == 0 && file_stat.st_size > 0) {
+      void* data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+      if (data != MAP_FAILED) {
+        data_ = static_cast<const char*>(data);
+        size_ = static_cast<size_t>(file_stat.st_size);
+      }
+    }
+    close(descriptor);
+  }
+
+  ~MappedFile() {
+    if (data_) {
+      munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  const char* Data() const { return data_; }
+  size_t Size() const { return size_; }
+
+ private:
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// Sequential reader of records; records are copied out because the file gives no alignment guarantees
+class RecordReader {
+ public:
+  RecordReader(const char* data, const size_t size) : data_(data), size_(size) {}
+
+  template <typename Record>
+  bool Read(Record& record) {
+    if (size_ - offset_ < sizeof(Record)) {
+      return false;
+    }
+    std::memcpy(&record, data_ + offset_, sizeof(Record));
+    offset_ += sizeof(Record);
+    return true;
+  }
+
+  template <typename Record, typename ModelObject>
+  bool ReadAll(const size_t count, std::vector<ModelObject>& result) {
+    result.clear();
+    result.reserve(count);
+    Record record;
+    for (size_t i = 0; i < count; i++) {
+      if (!Read(record)) {
+        return false;
+      }
+      result.push_back(record.ToModel());
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return offset_ == size_; }
+
+ private:
+  const char* data_;
+  const size_t size_;
+  size_t offset_ = 0;
+};
+
+const char* ActionTypeName(const ActionType& action) {
+  switch (action) {
+    case ActionType::CLEAR_AND_SELECT: return "CLEAR_AND_SELECT";
+    case ActionType::ADD_TO_SELECTION: return "ADD_TO_SELECTION";
+    case ActionType::DESELECT: return "DESELECT";
+    case ActionType::ASSIGN: return "ASSIGN";
+    case ActionType::DISMISS: return "DISMISS";
+    case ActionType::DISBAND: return "DISBAND";
+    case ActionType::MOVE: return "MOVE";
+    case ActionType::ROTATE: return "ROTATE";
+    case ActionType::SCALE: return "SCALE";
+    case ActionType::SETUP_VEHICLE_PRODUCTION: return "SETUP_VEHICLE_PRODUCTION";
+    case ActionType::TACTICAL_NUCLEAR_STRIKE: return "TACTICAL_NUCLEAR_STRIKE";
+    default: return "NONE";
+  }
+}
+
+std::string DescribeMove(const int tick, const Move& move) {
+  char buffer[512];
+  snprintf(buffer, sizeof(buffer),
+           "%d %s left=%.3f top=%.3f right=%.3f bottom=%.3f x=%.3f y=%.3f angle=%.5f factor=%.3f "
+           "max_speed=%.3f vehicle_type=%d facility=%lld vehicle=%lld",
+           tick, ActionTypeName(move.getAction()), move.getLeft(), move.getTop(), move.getRight(),
+           move.getBottom(), move.getX(), move.getY(), move.getAngle(), move.getFactor(), move.getMaxSpeed(),
+           static_cast<int>(move.getVehicleType()), move.getFacilityId(), move.getVehicleId());
+  return buffer;
+}
+
+// FNV-1a
+void HashString(const std::string& line, std::uint64_t& hash) {
+  for (const char c : line) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <recording> [--quiet]\n", argv[0]);
+    return 1;
+  }
+  const bool quiet = argc > 2 && std::strcmp(argv[2], "--quiet") == 0;
+
+  const MappedFile file(argv[1]);
+  if (!file.Data()) {
+    fprintf(stderr, "Can't read %s\n", argv[1]);
+    return 1;
+  }
+  RecordReader reader(file.Data(), file.Size());
+
+  RecordingHeader header;
+  if (!reader.Read(header) || std::memcmp(header.magic, kRecordingMagic, sizeof(header.magic)) != 0 ||
+      header.version != kRecordingVersion) {
+    fprintf(stderr, "%s is not a recording of a supported version\n", argv[1]);
+    return 1;
+  }
+  const Game game = header.game.ToModel();
+
+  const size_t columns = static_cast<size_t>(header.terrain_weather_columns);
+  const size_t rows = static_cast<size_t>(header.terrain_weather_rows);
+  std::vector<std::vector<TerrainType>> terrain(columns, std::vector<TerrainType>(rows));
+  std::vector<std::vector<WeatherType>> weather(columns, std::vector<WeatherType>(rows));
+  std::int8_t cell = 0;
+  for (auto& column : terrain) {
+    for (TerrainType& terrain_cell : column) {
+      reader.Read(cell);
+      terrain_cell = static_cast<TerrainType>(cell);
+    }
+  }
+  for (auto& column : weather) {
+    for (WeatherType& weather_cell : column) {
+      reader.Read(cell);
+      weather_cell = static_cast<WeatherType>(cell);
+    }
+  }
+
+  std::vector<Player> players;
+  std::vector<Vehicle> new_vehicles;
+  std::vector<VehicleUpdate> vehicle_updates;
+  std::vector<Facility> facilities;
+  int ticks_count = 0;
+  int actions_count = 0;
+  std::uint64_t actions_hash = 14695981039346656037ULL;
+  double strategy_seconds = 0;
+
+  // Before the strategy creates its CpuGovernor
+  setenv("MY_STRATEGY_QUALITY_LEVEL", "FULL", 0);
+  setenv("MY_STRATEGY_NO_PLANNING_DEADLINE", "1", 0);
+
+  {
+    // Destroyed before the summary below, so that its own summary (with -DMY_STRATEGY_PROFILING) goes first
+    MyStrategy strategy;
+    RecordedTickHeader tick_header = {};
+    while (!reader.AtEnd()) {
+      if (!reader.Read(tick_header) ||
+          !reader.ReadAll<RecordedPlayer>(tick_header.players_count, players) ||
+          !reader.ReadAll<RecordedVehicle>(tick_header.new_vehicles_count, new_vehicles) ||
+          !reader.ReadAll<RecordedVehicleUpdate>(tick_header.vehicle_updates_count, vehicle_updates) ||
+          !reader.ReadAll<RecordedFacility>(tick_header.facilities_count, facilities)) {
+        fprintf(stderr, "The recording is truncated after %d ticks\n", ticks_count);
+        break;
+      }
+      const World world(tick_header.tick_index, tick_header.tick_count, tick_header.width, tick_header.height,
+                        players, new_vehicles, vehicle_updates, terrain, weather, facilities);
+      const Player me = world.getMyPlayer();
+
+      Move move;
+      const auto start = std::chrono::steady_clock::now();
+      strategy.move(me, world, game, move);
+      strategy_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      ticks_count++;
+
+      if (move.getAction() != ActionType::NONE && move.getAction() != ActionType::_UNKNOWN_) {
+        const std::string line = DescribeMove(tick_header.tick_index, move);
+        HashString(line, actions_hash);
+        actions_count++;
+        if (!quiet) {
+          printf("%s\n", line.c_str());
+        }
+      }
+    }
+  }
+
+  fprintf(stderr, "ticks: %d, actions: %d, strategy time: %.3f s (%.0f ticks/s), actions hash: %016llx\n",
+          ticks_count, actions_count, strategy_seconds,
+          strategy_seconds > 0 ? ticks_count / strategy_seconds : 0.0,
+          static_cast<unsigned long long>(actions_hash));
+  return 0;
+}